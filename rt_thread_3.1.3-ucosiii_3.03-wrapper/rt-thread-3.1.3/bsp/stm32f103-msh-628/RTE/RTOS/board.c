@@ -20,6 +20,10 @@
 #define _SYSTICK_CALIB  (*(rt_uint32_t *)(_SCB_BASE + 0xC))
 #define _SYSTICK_PRI    (*(rt_uint8_t  *)(0xE000ED23UL))
 
+#define _SYSTICK_CTRL_ENABLE        (1UL << 0)
+#define _SYSTICK_CTRL_COUNTFLAG     (1UL << 16)
+#define _SYSTICK_CTRL_STOP          0x06    /* CLKSOURCE | TICKINT, counter disabled */
+
 
 void SystemClock_Config(void);
 // Updates the variable SystemCoreClock and must be called
@@ -46,6 +50,102 @@ static uint32_t _SysTick_Config(rt_uint32_t ticks)
     return 0;
 }
 
+#ifdef BSP_USING_TICKLESS_IDLE
+#ifndef RT_USING_IDLE_HOOK
+#error "BSP_USING_TICKLESS_IDLE needs RT_USING_IDLE_HOOK"
+#endif
+
+static rt_uint32_t _tick_cycles;    /* SysTick counts per OS tick */
+static rt_uint32_t _tickless_max;   /* max OS ticks one SysTick reload can cover (24-bit counter) */
+
+/*
+ * Idle hook: stop the periodic SysTick, reprogram it to fire once at the
+ * next timer expiry and sleep (WFI).  On wakeup the ticks slept through are
+ * added to the OS tick with rt_tick_set() and SysTick goes back to periodic.
+ * If the long period expired, its interrupt is left pending and
+ * SysTick_Handler counts the last tick (and checks the timers) as usual.
+ * Interrupts stay disabled (PRIMASK) around WFI; a pending interrupt still
+ * wakes the core and is taken right after rt_hw_interrupt_enable().
+ * SysTick is always stopped before PENDSTSET/COUNTFLAG are read, so a tick
+ * that expires meanwhile is seen once and counted once (by SysTick_Handler).
+ * Not verified on hardware yet, see tickless_bench in the uCOS-III wrapper.
+ */
+static void _tickless_idle(void)
+{
+    rt_base_t level;
+    rt_tick_t next, sleep_tick, complete;
+    rt_uint32_t reload, elapsed, ctrl;
+
+    level = rt_hw_interrupt_disable();
+
+    next = rt_timer_next_timeout_tick();
+    sleep_tick = (next == RT_TICK_MAX) ? _tickless_max : next - rt_tick_get();
+    if (sleep_tick < 2)
+    {
+        /* a timer expires at the next tick */
+        rt_hw_interrupt_enable(level);
+        return;
+    }
+    if (sleep_tick > _tickless_max)
+    {
+        sleep_tick = _tickless_max;
+    }
+
+    /* stop first: once stopped the counter cannot wrap between the check below and reading VAL */
+    _SYSTICK_CTRL = _SYSTICK_CTRL_STOP;
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        /* the current tick expired but is not counted yet, VAL already belongs
+         * to the next one: keep counting and let SysTick_Handler count it */
+        _SYSTICK_CTRL = _SYSTICK_CTRL_STOP | _SYSTICK_CTRL_ENABLE;
+        rt_hw_interrupt_enable(level);
+        return;
+    }
+
+    /* rest of the current tick + (sleep_tick - 1) whole ticks */
+    reload = _SYSTICK_VAL + (sleep_tick - 1) * _tick_cycles;
+    _SYSTICK_LOAD = reload;
+    _SYSTICK_VAL  = 0;
+    _SYSTICK_CTRL = _SYSTICK_CTRL_STOP | _SYSTICK_CTRL_ENABLE;
+
+    __DSB();
+    __WFI();
+    __ISB();
+
+    /* writing VAL above cleared COUNTFLAG; read it once, after the counter has stopped */
+    _SYSTICK_CTRL = _SYSTICK_CTRL_STOP;
+    ctrl = _SYSTICK_CTRL;
+    if (ctrl & _SYSTICK_CTRL_COUNTFLAG)
+    {
+        /* slept the whole period, the counter reloaded and went on counting */
+        elapsed  = reload - _SYSTICK_VAL;
+        complete = sleep_tick - 1;      /* the pending SysTick interrupt counts the last one */
+        _SYSTICK_LOAD = (elapsed < _tick_cycles - 1) ? _tick_cycles - 1 - elapsed : _tick_cycles - 1;
+    }
+    else
+    {
+        /* woken early by another interrupt */
+        elapsed  = sleep_tick * _tick_cycles - _SYSTICK_VAL;
+        complete = elapsed / _tick_cycles;
+        _SYSTICK_LOAD = (complete + 1) * _tick_cycles - elapsed - 1;
+    }
+    _SYSTICK_VAL  = 0;
+    _SYSTICK_CTRL = _SYSTICK_CTRL_STOP | _SYSTICK_CTRL_ENABLE;
+    _SYSTICK_LOAD = _tick_cycles - 1;   /* takes effect from the next reload */
+
+    rt_tick_set(rt_tick_get() + complete);
+
+    rt_hw_interrupt_enable(level);
+}
+
+static void _tickless_init(rt_uint32_t tick_cycles)
+{
+    _tick_cycles  = tick_cycles;
+    _tickless_max = 0xFFFFFF / tick_cycles;
+    rt_thread_idle_sethook(_tickless_idle);
+}
+#endif
+
 #if defined(RT_USING_USER_MAIN) && defined(RT_USING_HEAP)
 #define RT_HEAP_SIZE 2048
 static uint32_t rt_heap[RT_HEAP_SIZE];  
@@ -73,6 +173,10 @@ void rt_hw_board_init()
     /* System Tick Configuration */
     _SysTick_Config(SystemCoreClock / RT_TICK_PER_SECOND);
 
+#ifdef BSP_USING_TICKLESS_IDLE
+    _tickless_init(SystemCoreClock / RT_TICK_PER_SECOND);
+#endif
+
     /* Call components board initial (use INIT_BOARD_EXPORT()) */
 #ifdef RT_USING_COMPONENTS_INIT
     rt_components_board_init();
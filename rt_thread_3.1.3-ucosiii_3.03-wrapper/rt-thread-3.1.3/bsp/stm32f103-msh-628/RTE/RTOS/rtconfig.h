@@ -52,11 +52,20 @@
 // <h>Hook Configuration
 // <c1>using hook
 //  <i>using hook
-//#define RT_USING_HOOK
+#define RT_USING_HOOK
 // </c>
 // <c1>using idle hook
 //  <i>using idle hook
-//#define RT_USING_IDLE_HOOK
+#define RT_USING_IDLE_HOOK
+// </c>
+// </h>
+
+// <h>Power Management Configuration
+// <c1>tickless idle
+//  <i>SysTick is stopped in the idle thread and the CPU sleeps (WFI) until the next timer expires
+//  <i>needs RT_USING_IDLE_HOOK
+//  <i>cannot be used together with the uC/OS-III statistic task (OS_CFG_STAT_TASK_EN), whose idle counter stops while sleeping
+//#define BSP_USING_TICKLESS_IDLE
 // </c>
 // </h>
 
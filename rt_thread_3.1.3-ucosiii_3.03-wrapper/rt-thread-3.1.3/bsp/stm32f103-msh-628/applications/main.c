@@ -10,20 +10,57 @@
 
 #include "stm32f1xx_hal.h"
 #include <rtthread.h>
+#include <os.h>
 
 /*finshʹô2*/
 void sem_test (void);
 void timer_test (void);
 void mutex_test (void);
 void queue_test (void);
+void queue_del_test (void);
+void queue_static_test (void);
 void flag_test (void);
+void task_test (void);
+void stk_limit_test (void);
+void stat_test (void);
+void tls_test (void);
+void dly_resume_test (void);
+void post_all_bench (void);
+void post_burst_bench (void);
+void spsc_bench (void);
+void multi_bench (void);
+void task_sem_bench (void);
+void rr_bench (void);
+void dly_bench (void);
+void tickless_bench (void);
+void ts_bench (void);
 
 int main(void)
 {
+    OS_ERR err;
+    
+    OSInit(&err);/*ʼݲ(Ϣص),ڴuCOS-IIIں˶֮ǰ*/
+    
 //   sem_test();
     timer_test();
 //    mutex_test();
 //    queue_test();
+//    queue_del_test();
+//    queue_static_test();
 //    flag_test();
+//    task_test();
+//    stk_limit_test();
+//    stat_test();
+//    tls_test();
+//    dly_resume_test();
+//    post_all_bench();
+//    post_burst_bench();
+//    spsc_bench();
+//    multi_bench();
+//    task_sem_bench();
+//    rr_bench();
+//    dly_bench();
+//    tickless_bench();
+//    ts_bench();
 }
 
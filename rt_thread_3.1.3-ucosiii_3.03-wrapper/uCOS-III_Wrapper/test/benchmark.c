@@ -0,0 +1,799 @@
+#include <os.h>
+#include <stdint.h>
+
+/*
+ܲ:
+    ʹCortex-M3DWTڼʱ,λΪCPU,ÿظBENCH_ROUNDSȡƽֵ
+    ڵ(main߳)н,ѵȼȵ߸1,Ͷݺʱѵ
+*/
+
+#define DEM_CR              (*(volatile rt_uint32_t *)0xE000EDFCu)
+#define DWT_CR              (*(volatile rt_uint32_t *)0xE0001000u)
+#define DWT_CYCCNT          (*(volatile rt_uint32_t *)0xE0001004u)
+
+#define BENCH_ROUNDS        8
+#define BENCH_WAITER_MAX    16
+#define BENCH_WAITER_STK    256
+
+ALIGN(RT_ALIGN_SIZE)
+static char waiter_stack[BENCH_WAITER_MAX][BENCH_WAITER_STK];
+static struct rt_thread waiter[BENCH_WAITER_MAX];
+
+extern uint32_t SystemCoreClock;/*DWTڼHCLK,ΪʱʱʹʵʵƵ*/
+
+static OS_SEM bench_sem;
+static OS_Q   bench_q;
+static volatile rt_uint32_t woken;
+
+static void bench_cyccnt_init (void)
+{
+    DEM_CR     |= 1u << 24;/*TRCENA*/
+    DWT_CYCCNT  = 0u;
+    DWT_CR     |= 1u;/*CYCCNTENA*/
+}
+
+/* nȵȼ1ĵȴ,вڶӦں˶,Ϊ */
+static void bench_waiters_start (void (*entry)(void *param), int n)
+{
+    int i;
+    rt_uint8_t prio = rt_thread_self()->current_priority - 1;
+
+    for(i=0;i<n;i++)
+    {
+        rt_thread_init(&waiter[i],
+                       "bwait",
+                       entry,
+                       (void *)i,
+                       &waiter_stack[i][0],
+                       BENCH_WAITER_STK,
+                       prio, 5);
+        rt_thread_startup(&waiter[i]);
+    }
+}
+
+/* ------------------------------------- OS_OPT_POST_ALL 㲥ѭͶݵĶԱ ------------------------------------- */
+
+static void waiter_sem_entry (void *param)
+{
+    OS_ERR err;
+
+    OSSemPend(&bench_sem,0,OS_OPT_PEND_BLOCKING,0,&err);
+    woken++;
+}
+
+static void waiter_q_entry (void *param)
+{
+    OS_ERR err;
+    OS_MSG_SIZE size;
+
+    OSQPend(&bench_q,0,OS_OPT_PEND_BLOCKING,&size,0,&err);
+    woken++;
+}
+
+/* ӿʼͶݵnȴȫõ */
+static rt_uint32_t post_all_round (int is_q, int n, int broadcast)
+{
+    OS_ERR err;
+    int i;
+    rt_uint32_t start, cycles;
+
+    woken = 0;
+    bench_waiters_start(is_q ? waiter_q_entry : waiter_sem_entry, n);
+
+    start = DWT_CYCCNT;
+    if(broadcast)
+    {
+        if(is_q)
+        {
+            OSQPost(&bench_q,RT_NULL,0,OS_OPT_POST_FIFO|OS_OPT_POST_ALL,&err);
+        }
+        else
+        {
+            OSSemPost(&bench_sem,OS_OPT_POST_ALL,&err);
+        }
+    }
+    else
+    {
+        for(i=0;i<n;i++)
+        {
+            if(is_q)
+            {
+                OSQPost(&bench_q,RT_NULL,0,OS_OPT_POST_FIFO,&err);
+            }
+            else
+            {
+                OSSemPost(&bench_sem,OS_OPT_POST_1,&err);
+            }
+        }
+    }
+    cycles = DWT_CYCCNT - start;
+
+    if(woken != n)
+    {
+        rt_kprintf("post_all_bench: %d of %d waiters woke up!\r\n",woken,n);
+    }
+    return cycles;
+}
+
+void post_all_bench (void)
+{
+    static const int nbr_waiters[] = {1, 4, 16};
+    OS_ERR err;
+    int i, round, is_q;
+    rt_uint32_t all, loop;
+
+    bench_cyccnt_init();
+    OSSemCreate(&bench_sem,"bench sem",0,&err);
+    OSQCreate(&bench_q,"bench q",1,&err);
+
+    for(i=0;i<sizeof(nbr_waiters)/sizeof(nbr_waiters[0]);i++)
+    {
+        for(is_q=0;is_q<2;is_q++)
+        {
+            all = 0;
+            loop = 0;
+            for(round=0;round<BENCH_ROUNDS;round++)
+            {
+                all  += post_all_round(is_q, nbr_waiters[i], 1);
+                loop += post_all_round(is_q, nbr_waiters[i], 0);
+            }
+            rt_kprintf("%s waiters:%2d  POST_ALL:%6d cycles  looped POST_1:%6d cycles\r\n",
+                       is_q ? "OSQPost  " : "OSSemPost",
+                       nbr_waiters[i],
+                       all/BENCH_ROUNDS,
+                       loop/BENCH_ROUNDS);
+        }
+    }
+
+    OSQDel(&bench_q,OS_OPT_DEL_ALWAYS,&err);
+    OSSemDel(&bench_sem,OS_OPT_DEL_ALWAYS,&err);
+}
+
+/* --------------------------------- OS_OPT_POST_NO_SCHED Ͷ8ں˶ --------------------------------- */
+
+#define BURST_NBR           8
+
+static OS_SEM burst_sem[BURST_NBR];
+
+static void waiter_burst_entry (void *param)
+{
+    OS_ERR err;
+
+    OSSemPend(&burst_sem[(int)param],0,OS_OPT_PEND_BLOCKING,0,&err);
+    woken++;
+}
+
+/* ͶBURST_NBRźֱȴȫõ */
+static rt_uint32_t post_burst_round (int no_sched)
+{
+    OS_ERR err;
+    int i;
+    rt_uint32_t start, cycles;
+
+    woken = 0;
+    bench_waiters_start(waiter_burst_entry, BURST_NBR);
+
+    start = DWT_CYCCNT;
+    for(i=0;i<BURST_NBR;i++)
+    {
+        /*һⶼ,һͶͳһ*/
+        if(no_sched && i != BURST_NBR-1)
+        {
+            OSSemPost(&burst_sem[i],OS_OPT_POST_1|OS_OPT_POST_NO_SCHED,&err);
+        }
+        else
+        {
+            OSSemPost(&burst_sem[i],OS_OPT_POST_1,&err);
+        }
+    }
+    cycles = DWT_CYCCNT - start;
+
+    if(woken != BURST_NBR)
+    {
+        rt_kprintf("post_burst_bench: %d of %d waiters woke up!\r\n",woken,BURST_NBR);
+    }
+    return cycles;
+}
+
+void post_burst_bench (void)
+{
+    OS_ERR err;
+    int i, round;
+    rt_uint32_t sched, no_sched;
+
+    bench_cyccnt_init();
+    for(i=0;i<BURST_NBR;i++)
+    {
+        OSSemCreate(&burst_sem[i],"burst sem",0,&err);
+    }
+
+    sched = 0;
+    no_sched = 0;
+    for(round=0;round<BENCH_ROUNDS;round++)
+    {
+        sched    += post_burst_round(0);
+        no_sched += post_burst_round(1);
+    }
+    rt_kprintf("burst of %d posts  POST_1:%6d cycles  POST_NO_SCHED:%6d cycles\r\n",
+               BURST_NBR,
+               sched/BENCH_ROUNDS,
+               no_sched/BENCH_ROUNDS);
+
+    for(i=0;i<BURST_NBR;i++)
+    {
+        OSSemDel(&burst_sem[i],OS_OPT_DEL_ALWAYS,&err);
+    }
+}
+
+/* ------------------------------------ SPSCϢͨϢеĶԱ ------------------------------------ */
+
+#if OS_CFG_Q_SPSC_EN > 0u
+
+#define SPSC_Q_SIZE         16
+
+static OS_Q   spsc_q;
+static OS_MSG spsc_tbl[SPSC_Q_SIZE];
+
+/* ûȴʱ,Ͷȫȡõ,ֱۼӵpostpend */
+static void spsc_round (OS_Q *p_q, rt_uint32_t *post, rt_uint32_t *pend)
+{
+    OS_ERR err;
+    OS_MSG_SIZE size;
+    int i;
+    rt_uint32_t start;
+
+    start = DWT_CYCCNT;
+    for(i=0;i<SPSC_Q_SIZE;i++)
+    {
+        OSQPost(p_q,(void *)i,0,OS_OPT_POST_FIFO,&err);
+    }
+    *post += DWT_CYCCNT - start;
+
+    start = DWT_CYCCNT;
+    for(i=0;i<SPSC_Q_SIZE;i++)
+    {
+        OSQPend(p_q,0,OS_OPT_PEND_NON_BLOCKING,&size,0,&err);
+    }
+    *pend += DWT_CYCCNT - start;
+}
+
+void spsc_bench (void)
+{
+    OS_ERR err;
+    int round;
+    rt_uint32_t q_post, q_pend, spsc_post, spsc_pend;
+
+    bench_cyccnt_init();
+    OSQCreate(&bench_q,"bench q",SPSC_Q_SIZE,&err);
+    OSQCreateSPSC(&spsc_q,"spsc q",spsc_tbl,SPSC_Q_SIZE,&err);
+
+    q_post = q_pend = spsc_post = spsc_pend = 0;
+    for(round=0;round<BENCH_ROUNDS;round++)
+    {
+        spsc_round(&bench_q, &q_post, &q_pend);
+        spsc_round(&spsc_q, &spsc_post, &spsc_pend);
+    }
+    rt_kprintf("OSQPost  OS_Q:%5d cycles  SPSC:%5d cycles\r\n",
+               q_post/(BENCH_ROUNDS*SPSC_Q_SIZE),
+               spsc_post/(BENCH_ROUNDS*SPSC_Q_SIZE));
+    rt_kprintf("OSQPend  OS_Q:%5d cycles  SPSC:%5d cycles\r\n",
+               q_pend/(BENCH_ROUNDS*SPSC_Q_SIZE),
+               spsc_pend/(BENCH_ROUNDS*SPSC_Q_SIZE));
+
+    OSQDel(&spsc_q,OS_OPT_DEL_ALWAYS,&err);
+    OSQDel(&bench_q,OS_OPT_DEL_ALWAYS,&err);
+}
+
+#endif
+
+/* ---------------------------------- OSQPostMulti/OSQPendMulti շ ---------------------------------- */
+
+#if OS_CFG_Q_MULTI_EN > 0u
+
+#define MULTI_BATCH_MAX     32          /* ҪOS_CFG_MSG_POOL_SIZEСڸֵ */
+#define MULTI_MSG_NBR       (MULTI_BATCH_MAX*BENCH_ROUNDS)
+
+static void        *multi_void[MULTI_BATCH_MAX];
+static OS_MSG_SIZE  multi_size[MULTI_BATCH_MAX];
+
+/* ڵͶbatchϢȫȡ,շMULTI_MSG_NBRϢ,ÿշϢ;batchΪ0ʾʹOSQPost/OSQPend */
+static rt_uint32_t multi_round (int batch)
+{
+    OS_ERR err;
+    int i, n;
+    rt_uint32_t start, cycles;
+
+    start = DWT_CYCCNT;
+    for(n=0;n<MULTI_MSG_NBR;n+=(batch ? batch : 1))
+    {
+        if(batch == 0)
+        {
+            OSQPost(&bench_q,(void *)n,0,OS_OPT_POST_FIFO,&err);
+            OSQPend(&bench_q,0,OS_OPT_PEND_NON_BLOCKING,&multi_size[0],0,&err);
+        }
+        else
+        {
+            if(OSQPostMulti(&bench_q,multi_void,multi_size,batch,OS_OPT_POST_FIFO,&err) != batch)
+            {
+                rt_kprintf("multi_bench: post err:%d!\r\n",err);
+            }
+            for(i=0;i<batch;i+=OSQPendMulti(&bench_q,0,OS_OPT_PEND_NON_BLOCKING,multi_void,multi_size,batch,0,&err))
+            {
+                if(err != OS_ERR_NONE)
+                {
+                    rt_kprintf("multi_bench: pend err:%d!\r\n",err);
+                    break;
+                }
+            }
+        }
+    }
+    cycles = DWT_CYCCNT - start;
+
+    return (rt_uint32_t)((rt_uint64_t)MULTI_MSG_NBR * SystemCoreClock / cycles);
+}
+
+void multi_bench (void)
+{
+    static const int batch[] = {1, 8, 32};
+    OS_ERR err;
+    int i;
+
+    bench_cyccnt_init();
+    OSQCreate(&bench_q,"bench q",MULTI_BATCH_MAX,&err);
+
+    rt_kprintf("OSQPost/OSQPend          batch: 1  %8d msg/s\r\n",multi_round(0));
+    for(i=0;i<sizeof(batch)/sizeof(batch[0]);i++)
+    {
+        rt_kprintf("OSQPostMulti/OSQPendMulti batch:%2d  %8d msg/s\r\n",batch[i],multi_round(batch[i]));
+    }
+
+    OSQDel(&bench_q,OS_OPT_DEL_ALWAYS,&err);
+}
+
+#endif
+
+/* ------------------------------------- ڽźOSSemPostĶԱ ------------------------------------- */
+
+#define TASK_SEM_STK_SIZE   (BENCH_WAITER_STK/sizeof(CPU_STK))
+
+static OS_TCB  task_sem_tcb[2];/*0:е 1:ȴ*/
+static CPU_STK task_sem_stk[2][TASK_SEM_STK_SIZE];
+
+static void task_sem_idle_entry (void *param)
+{
+    /*ȼȵߵ,ڼ䲻*/
+}
+
+static void task_sem_waiter_entry (void *param)
+{
+    OS_ERR err;
+
+    do
+    {
+        OSTaskSemPend(0,OS_OPT_PEND_BLOCKING,0,&err);
+        woken++;
+    }while(err == OS_ERR_NONE);
+}
+
+static void sem_waiter_entry (void *param)
+{
+    OS_ERR err;
+
+    do
+    {
+        OSSemPend(&bench_sem,0,OS_OPT_PEND_BLOCKING,0,&err);
+        woken++;
+    }while(err == OS_ERR_NONE);
+}
+
+/* ƽÿͶõ,p_tcbΪNULLʱͶbench_sem,Ͷp_tcbڽź */
+static rt_uint32_t task_sem_round (OS_TCB *p_tcb)
+{
+    OS_ERR err;
+    int i;
+    rt_uint32_t start, cycles;
+
+    woken = 0;
+    start = DWT_CYCCNT;
+    for(i=0;i<BENCH_ROUNDS;i++)
+    {
+        if(p_tcb != RT_NULL)
+        {
+            OSTaskSemPost(p_tcb,OS_OPT_POST_NONE,&err);
+        }
+        else
+        {
+            OSSemPost(&bench_sem,OS_OPT_POST_1,&err);
+        }
+    }
+    cycles = DWT_CYCCNT - start;
+
+    return cycles/BENCH_ROUNDS;
+}
+
+static void task_sem_create (int i, void (*entry)(void *param), OS_PRIO prio)
+{
+    OS_ERR err;
+
+    OSTaskCreate(&task_sem_tcb[i],
+                 (CPU_CHAR*)"bsem",
+                 entry,
+                 0,
+                 prio,
+                 task_sem_stk[i],
+                 TASK_SEM_STK_SIZE/10,
+                 TASK_SEM_STK_SIZE,
+                 0,
+                 5,
+                 0,
+                 OS_OPT_TASK_NONE,
+                 &err);
+}
+
+void task_sem_bench (void)
+{
+    OS_ERR err;
+    OS_PRIO prio = rt_thread_self()->current_priority;
+    rt_uint32_t sem, task;
+
+    bench_cyccnt_init();
+
+    /*ûȴ:߶ֻǼֵ1*/
+    OSSemCreate(&bench_sem,"bench sem",0,&err);
+    task_sem_create(0, task_sem_idle_entry, prio+1);
+    sem  = task_sem_round(RT_NULL);
+    task = task_sem_round(&task_sem_tcb[0]);
+    rt_kprintf("post, no waiter    OSSemPost:%5d cycles  OSTaskSemPost:%5d cycles\r\n",sem,task);
+    OSTaskDel(&task_sem_tcb[0],&err);
+    OSSemDel(&bench_sem,OS_OPT_DEL_ALWAYS,&err);
+
+    /*ȴ:ͶݿʼȴٴΪֹ*/
+    OSSemCreate(&bench_sem,"bench sem",0,&err);
+    bench_waiters_start(sem_waiter_entry, 1);
+    sem = task_sem_round(RT_NULL);
+    if(woken != BENCH_ROUNDS)
+    {
+        rt_kprintf("task_sem_bench: OSSemPend woke %d of %d times!\r\n",woken,BENCH_ROUNDS);
+    }
+    OSSemDel(&bench_sem,OS_OPT_DEL_ALWAYS,&err);/*ȴ񱻻Ѻ˳*/
+
+    task_sem_create(1, task_sem_waiter_entry, prio-1);
+    task = task_sem_round(&task_sem_tcb[1]);
+    if(woken != BENCH_ROUNDS)
+    {
+        rt_kprintf("task_sem_bench: OSTaskSemPend woke %d of %d times!\r\n",woken,BENCH_ROUNDS);
+    }
+#if OS_CFG_TASK_SEM_PEND_ABORT_EN > 0u
+    OSTaskSemPendAbort(&task_sem_tcb[1],OS_OPT_POST_NONE,&err);/*ȴ񱻻Ѻ˳*/
+#else
+    OSTaskDel(&task_sem_tcb[1],&err);
+#endif
+    rt_kprintf("post, 1 waiter     OSSemPost:%5d cycles  OSTaskSemPost:%5d cycles\r\n",sem,task);
+}
+
+/* ---------------------------------- ͬʱƬµӳ ---------------------------------- */
+
+#define RR_WORKER_NBR       3
+#define RR_WINDOW_TICKS     500         /* ÿʱƬȵĲʱ */
+#define RR_STK_SIZE         (BENCH_WAITER_STK/sizeof(CPU_STK))
+
+static OS_TCB  rr_tcb[RR_WORKER_NBR];
+static CPU_STK rr_stk[RR_WORKER_NBR][RR_STK_SIZE];
+static volatile rt_uint32_t rr_work[RR_WORKER_NBR];    /* :ѭ */
+static volatile rt_uint32_t rr_last[RR_WORKER_NBR];    /* һѭʱDWT_CYCCNT */
+static volatile rt_uint32_t rr_gap_max;                 /* ֮(),ӳ */
+static volatile rt_uint32_t rr_window;                  /* ,ıԼrr_last[] */
+
+/* ͬȼĹ,ʼվ,ֻܿʱƬתóCPU */
+static void rr_worker_entry (void *param)
+{
+    int i = (int)param;
+    rt_uint32_t now, gap, window = rr_window;
+    CPU_SR_ALLOC();
+
+    while(1)
+    {
+        /*ʱ䡢Ƚϲrr_last[]rr_gap_maxĹ̲ܱrr_bench()ʼ´ڴ*/
+        CPU_CRITICAL_ENTER();
+        now = DWT_CYCCNT;
+        if(window != rr_window)
+        {
+            window = rr_window;/*´ڵĵһ,ֻ¼ʱ*/
+        }
+        else
+        {
+            gap = now - rr_last[i];
+            if(gap > rr_gap_max)
+            {
+                rr_gap_max = gap;
+            }
+        }
+        rr_last[i] = now;
+        rr_work[i]++;
+        CPU_CRITICAL_EXIT();
+    }
+}
+
+void rr_bench (void)
+{
+    static const OS_TICK quanta[] = {1, 5, 20, 100};
+    OS_ERR err;
+    OS_PRIO prio = rt_thread_self()->current_priority + 1;/*ȵߵ,ʱڼ*/
+    rt_uint32_t work;
+    int i, j;
+    CPU_SR_ALLOC();
+
+    bench_cyccnt_init();
+    for(i=0;i<RR_WORKER_NBR;i++)
+    {
+        OSTaskCreate(&rr_tcb[i],
+                     (CPU_CHAR*)"rr",
+                     rr_worker_entry,
+                     (void *)i,
+                     prio,
+                     rr_stk[i],
+                     RR_STK_SIZE/10,
+                     RR_STK_SIZE,
+                     0,
+                     0,/*ʹOSSchedRoundRobinCfg()õĬʱƬ*/
+                     0,
+                     OS_OPT_TASK_NONE,
+                     &err);
+    }
+
+    for(j=0;j<sizeof(quanta)/sizeof(quanta[0]);j++)
+    {
+        OSSchedRoundRobinCfg(DEF_ENABLED,quanta[j],&err);
+
+        CPU_CRITICAL_ENTER();
+        for(i=0;i<RR_WORKER_NBR;i++)
+        {
+            rr_work[i] = 0;
+        }
+        rr_gap_max = 0;
+        rr_window++;/*rr_last[]ɸԼ*/
+        CPU_CRITICAL_EXIT();
+
+        OSTimeDly(RR_WINDOW_TICKS,OS_OPT_TIME_DLY,&err);
+
+        work = 0;
+        for(i=0;i<RR_WORKER_NBR;i++)
+        {
+            work += rr_work[i];
+        }
+        rt_kprintf("quanta:%3d ticks  throughput:%8d loops/tick  max latency:%6d us\r\n",
+                   quanta[j],
+                   work/RR_WINDOW_TICKS,
+                   rr_gap_max/(SystemCoreClock/1000000u));
+    }
+
+    for(i=0;i<RR_WORKER_NBR;i++)
+    {
+        OSTaskDel(&rr_tcb[i],&err);
+    }
+    OSSchedRoundRobinCfg(DEF_ENABLED,0,&err);/*ָĬ*/
+}
+
+/* ------------------------------- OS_OPT_TIME_PERIODICʱۻƯƺͶ ------------------------------- */
+
+#define DLY_PERIOD_TICKS    2
+#define DLY_PERIODS         100000u     /* ʱĲ */
+#define DLY_REL_PERIODS     1000u       /* ʱƯƺܿ,Ҫô */
+#define DLY_CYC_PER_TICK    (SystemCoreClock/RT_TICK_PER_SECOND)
+#define DLY_WORK_CYC        (DLY_CYC_PER_TICK*DLY_PERIOD_TICKS*3/4)    /* ÿڵĹ:ڵ3/4,Ƶ޹ */
+#define DLY_STK_SIZE        (BENCH_WAITER_STK/sizeof(CPU_STK))
+
+static OS_TCB  dly_tcb;
+static CPU_STK dly_stk[DLY_STK_SIZE];
+static OS_SEM  dly_done;
+
+/* :ÿռCPU DLY_WORK_CYC,ʱһ */
+static void dly_worker_entry (void *param)
+{
+    OS_OPT opt = (OS_OPT)(rt_uint32_t)param;
+    rt_uint32_t n = (opt == OS_OPT_TIME_PERIODIC) ? DLY_PERIODS : DLY_REL_PERIODS;
+    rt_uint32_t i, start, now, prev, interval, jitter, jitter_max = 0;
+    OS_TICK tick0;
+    OS_ERR err;
+
+    OSTimeDly(DLY_PERIOD_TICKS,opt,&err);/*뵽tick*/
+    tick0 = OSTimeGet(&err);
+    prev = DWT_CYCCNT;
+    for(i=0;i<n;i++)
+    {
+        start = DWT_CYCCNT;
+        while(DWT_CYCCNT - start < DLY_WORK_CYC);
+        OSTimeDly(DLY_PERIOD_TICKS,opt,&err);
+
+        now = DWT_CYCCNT;
+        interval = now - prev;
+        prev = now;
+        jitter = (interval > DLY_PERIOD_TICKS*DLY_CYC_PER_TICK) ? interval - DLY_PERIOD_TICKS*DLY_CYC_PER_TICK
+                                                                : DLY_PERIOD_TICKS*DLY_CYC_PER_TICK - interval;
+        if(jitter > jitter_max)
+        {
+            jitter_max = jitter;
+        }
+    }
+    rt_kprintf("%s periods:%6d  accumulated drift:%5d ticks  max jitter:%5d us\r\n",
+               (opt == OS_OPT_TIME_PERIODIC) ? "PERIODIC" : "DLY     ",
+               n,
+               (rt_int32_t)(OSTimeGet(&err) - tick0 - n*DLY_PERIOD_TICKS),
+               jitter_max/(SystemCoreClock/1000000u));
+    OSSemPost(&dly_done,OS_OPT_POST_1,&err);
+}
+
+void dly_bench (void)
+{
+    static const OS_OPT opts[] = {OS_OPT_TIME_PERIODIC, OS_OPT_TIME_DLY};
+    OS_ERR err;
+    int i;
+
+    bench_cyccnt_init();
+    OSSemCreate(&dly_done,"dly done",0,&err);
+    for(i=0;i<sizeof(opts)/sizeof(opts[0]);i++)
+    {
+        /*ȵȼ,غֵ*/
+        OSTaskCreate(&dly_tcb,
+                     (CPU_CHAR*)"dly",
+                     dly_worker_entry,
+                     (void *)(rt_uint32_t)opts[i],
+                     rt_thread_self()->current_priority - 1,
+                     dly_stk,
+                     DLY_STK_SIZE/10,
+                     DLY_STK_SIZE,
+                     0,
+                     0,
+                     0,
+                     OS_OPT_TASK_NO_TLS,
+                     &err);
+        OSSemPend(&dly_done,0,OS_OPT_PEND_BLOCKING,0,&err);
+    }
+    OSSemDel(&dly_done,OS_OPT_DEL_ALWAYS,&err);
+}
+
+/* ---------------------------------------- tickless idle³ʱtick ---------------------------------------- */
+
+/*
+    BSPBSP_USING_TICKLESS_IDLE,ʱSysTickرΪһ˯һʱ,ٲtick
+    ,OS tickƫǽʱ,ʱʱ֮ƫ;SysTickװ޵ʱ,ԸǷֶ˯ߵ
+    ˯(WFI)ڼDWTڼֹͣ,еTIM2Ϊοʱ:WFISleepģʽ,ʱӲͣ
+    TIM2ƵΪTICKLESS_TIM_HZ,16λԼ32һ,ʱܳ30
+    ע:ʹǰrtconfig.hдBSP_USING_TICKLESS_IDLE,os_cfg.hйرOS_CFG_STAT_TASK_EN
+    ʵ:δĿQEMUй,BSP_USING_TICKLESS_IDLEĬϹر;Ĭϴ֮ǰ,ĿбԲڴ˼¼
+*/
+
+#define RCC_CFGR            (*(volatile rt_uint32_t *)0x40021004u)
+#define RCC_APB1ENR         (*(volatile rt_uint32_t *)0x4002101Cu)
+#define TIM2_CR1            (*(volatile rt_uint32_t *)0x40000000u)
+#define TIM2_EGR            (*(volatile rt_uint32_t *)0x40000014u)
+#define TIM2_CNT            (*(volatile rt_uint32_t *)0x40000024u)
+#define TIM2_PSC            (*(volatile rt_uint32_t *)0x40000028u)
+#define TIM2_ARR            (*(volatile rt_uint32_t *)0x4000002Cu)
+
+#define TICKLESS_TIM_HZ     2000u       /* TIM2ļƵ,0.5msһ */
+
+/* TIM2Ϊ16λеϼ,ƵΪTICKLESS_TIM_HZ */
+static void tickless_tim_init (void)
+{
+    rt_uint32_t ppre1 = (RCC_CFGR >> 8) & 0x7u;
+    rt_uint32_t tim_clk;
+
+    /* APB1ƵʱʱʱӵHCLK,ΪPCLK12 */
+    tim_clk = (ppre1 < 4u) ? SystemCoreClock : (SystemCoreClock >> (ppre1 - 4u));
+
+    RCC_APB1ENR |= 1u;/*TIM2EN*/
+    TIM2_CR1 = 0u;
+    TIM2_PSC = tim_clk / TICKLESS_TIM_HZ - 1u;
+    TIM2_ARR = 0xFFFFu;
+    TIM2_EGR = 1u;/*UG,װԤƵֵ*/
+    TIM2_CNT = 0u;
+    TIM2_CR1 = 1u;/*CEN*/
+}
+
+void tickless_bench (void)
+{
+    static const rt_int32_t dly_ms[] = {2, 10, 100, 1000, 5000, 30000};
+    rt_uint32_t cnt0, wall_us, dly_us, diff_us, err_max = 0;
+    OS_TICK tick0, dly, ticks;
+    OS_ERR err;
+    int i;
+
+    tickless_tim_init();
+    for(i=0;i<sizeof(dly_ms)/sizeof(dly_ms[0]);i++)
+    {
+        dly = rt_tick_from_millisecond(dly_ms[i]);
+        dly_us = dly * (1000000u / RT_TICK_PER_SECOND);
+
+        OSTimeDly(1,OS_OPT_TIME_DLY,&err);/*뵽tick*/
+        cnt0  = TIM2_CNT;
+        tick0 = OSTimeGet(&err);
+        OSTimeDly(dly,OS_OPT_TIME_DLY,&err);
+        wall_us = ((TIM2_CNT - cnt0) & 0xFFFFu) * (1000000u / TICKLESS_TIM_HZ);
+        ticks   = OSTimeGet(&err) - tick0;
+
+        diff_us = (wall_us > dly_us) ? wall_us - dly_us : dly_us - wall_us;
+        if(diff_us > err_max)
+        {
+            err_max = diff_us;
+        }
+        rt_kprintf("delay:%6d ticks  os ticks:%6d  wall:%9d us  error:%6d us\r\n",dly,ticks,wall_us,diff_us);
+    }
+    /* һtick:󵽶ȡTIM2֮ӳ,ԼTIM20.5msķֱ */
+    rt_kprintf("tickless_bench %s, max error against TIM2:%d us\r\n",
+               (err_max <= 1000000u / RT_TICK_PER_SECOND) ? "pass" : "fail",err_max);
+}
+
+/* -------------------------------------- Ͷݵȴеӳ(p_ts) -------------------------------------- */
+
+/*
+    ȴOS_TS_GET()ȥp_tsõʱ,ͶݵԼʼ
+    ڶͶһϢʱ,֤ŶӵϢԼͶݵʱ,Ǳȡʱ
+*/
+
+static volatile rt_uint32_t ts_lat_sum, ts_lat_max;
+
+static void ts_waiter_entry (void *param)
+{
+    OS_ERR err;
+    CPU_TS ts;
+    rt_uint32_t lat;
+
+    do
+    {
+        OSSemPend(&bench_sem,0,OS_OPT_PEND_BLOCKING,&ts,&err);
+        if(err != OS_ERR_NONE)
+        {
+            break;
+        }
+        lat = OS_TS_GET() - ts;
+        ts_lat_sum += lat;
+        if(lat > ts_lat_max)
+        {
+            ts_lat_max = lat;
+        }
+        woken++;
+    }while(1);
+}
+
+void ts_bench (void)
+{
+    OS_ERR err;
+    OS_MSG_SIZE size;
+    CPU_TS ts;
+    CPU_TS64 ts64;
+    rt_uint32_t age;
+    int i;
+
+    OSSemCreate(&bench_sem,"bench sem",0,&err);
+    woken = 0;
+    ts_lat_sum = 0;
+    ts_lat_max = 0;
+    bench_waiters_start(ts_waiter_entry, 1);
+    for(i=0;i<BENCH_ROUNDS;i++)
+    {
+        OSSemPost(&bench_sem,OS_OPT_POST_1,&err);
+        OSTimeDly(1,OS_OPT_TIME_DLY,&err);
+    }
+    OSSemDel(&bench_sem,OS_OPT_DEL_ALWAYS,&err);/*ȴ񱻻Ѻ˳*/
+    if(woken != BENCH_ROUNDS)
+    {
+        rt_kprintf("ts_bench: OSSemPend woke %d of %d times!\r\n",woken,BENCH_ROUNDS);
+    }
+    else
+    {
+        rt_kprintf("post->pend latency  avg:%5d cycles  max:%5d cycles\r\n",ts_lat_sum/BENCH_ROUNDS,ts_lat_max);
+    }
+
+    OSQCreate(&bench_q,"bench q",1,&err);
+    OSQPost(&bench_q,(void*)1,1,OS_OPT_POST_FIFO,&err);
+    OSTimeDly(10,OS_OPT_TIME_DLY,&err);
+    OSQPend(&bench_q,0,OS_OPT_PEND_NON_BLOCKING,&size,&ts,&err);
+    age = OS_TS_GET() - ts;
+    rt_kprintf("queued msg age:%d us (expect ~%d us)\r\n",
+               age/(SystemCoreClock/1000000u),10*1000000u/RT_TICK_PER_SECOND);
+    OSQDel(&bench_q,OS_OPT_DEL_ALWAYS,&err);
+
+    ts64 = CPU_TS_Get64();
+    rt_kprintf("64-bit timestamp: %d s since start\r\n",(rt_uint32_t)(ts64/SystemCoreClock));
+}
@@ -102,3 +102,133 @@ void queue_test (void)
     rt_thread_startup(&thread3); 
 
 }
+
+/* ɾڵȴϢе,֮öͶ:ϢӦڶ,ǽɾĶջ */
+#define DEL_TASK_STK_SIZE   (THREAD_STACK_SIZE/sizeof(CPU_STK))
+
+static OS_Q    del_q;
+static OS_TCB  del_tcb;
+static CPU_STK del_stk[DEL_TASK_STK_SIZE];
+#if OS_CFG_Q_SPSC_EN > 0u
+static OS_MSG  del_msg_tbl[DATAMSG_Q_NUM];
+#endif
+static struct rt_messagequeue del_rt_mq;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t del_rt_mq_pool[32];
+
+static void del_pend_entry(void *param)
+{
+    OS_Q *p_q = (OS_Q *)param;
+    OS_MSG_SIZE size;
+    OS_ERR err;
+
+    OSQPend(p_q,0,OS_OPT_PEND_BLOCKING,&size,0,&err);
+    rt_kprintf("queue_del_test: deleted task woke up, err:%d!\r\n",err);
+}
+
+static void queue_del_round(const char *name)
+{
+    OS_ERR err, err_pend;
+    OS_MSG_SIZE size;
+    void *p;
+
+    /*ȼȵ߸,вڶ*/
+    OSTaskCreate(&del_tcb,
+                 (CPU_CHAR*)"qdel",
+                 del_pend_entry,
+                 (void*)&del_q,
+                 rt_thread_self()->current_priority - 1,
+                 del_stk,
+                 DEL_TASK_STK_SIZE/10,
+                 DEL_TASK_STK_SIZE,
+                 0,
+                 0,
+                 0,
+                 OS_OPT_TASK_NONE,
+                 &err);
+    OSTaskDel(&del_tcb,&err);
+    rt_memset(del_stk,0xA5,sizeof(del_stk));/*ģⱻɾĶջʹ*/
+
+    OSQPost(&del_q,(void*)1,1,OS_OPT_POST_FIFO,&err);
+    p = OSQPend(&del_q,0,OS_OPT_PEND_NON_BLOCKING,&size,0,&err_pend);/*ϢӦڶ*/
+    if(err == OS_ERR_NONE && err_pend == OS_ERR_NONE && p == (void*)1)
+    {
+        rt_kprintf("queue_del_test %s: pass\r\n",name);
+    }
+    else
+    {
+        rt_kprintf("queue_del_test %s: fail, post err:%d pend err:%d\r\n",name,err,err_pend);
+    }
+    OSQDel(&del_q,OS_OPT_DEL_ALWAYS,&err);
+}
+
+void queue_del_test (void)
+{
+    OS_ERR err;
+
+    /*RTTԭϢOS_Qͬһ,ݲOS_QʱOS_Q*/
+    rt_mq_init(&del_rt_mq,"del mq",del_rt_mq_pool,sizeof(rt_uint32_t),sizeof(del_rt_mq_pool),RT_IPC_FLAG_FIFO);
+    OSQCreate(&del_q,"del q",DATAMSG_Q_NUM,&err);
+    queue_del_round("OSQCreate");
+#if OS_CFG_Q_SPSC_EN > 0u
+    OSQCreateSPSC(&del_q,"del q",del_msg_tbl,DATAMSG_Q_NUM,&err);
+    queue_del_round("OSQCreateSPSC");
+#endif
+    rt_mq_detach(&del_rt_mq);
+}
+
+#if OS_CFG_Q_STATIC_EN > 0u
+/* OSQCreateStatic:ϢȡԵ÷ṩOS_MSG,ʱOS_ERR_Q_MAX,ҲռȫϢ */
+static OS_Q   static_q;
+static OS_MSG static_msg_tbl[DATAMSG_Q_NUM];
+
+void queue_static_test (void)
+{
+    OS_ERR err;
+    OS_MSG_SIZE size;
+    OS_MSG_QTY pool_free;
+    int i, fail = 0;
+    void *p;
+
+    OSQCreateStatic(&static_q,"static q",static_msg_tbl,DATAMSG_Q_NUM,&err);
+    if(err != OS_ERR_NONE)
+    {
+        rt_kprintf("queue_static_test: create err:%d!\r\n",err);
+        return;
+    }
+
+    pool_free = OSMsgPool.NbrFree;
+    for(i=0;i<DATAMSG_Q_NUM;i++)
+    {
+        OSQPost(&static_q,(void*)(i+1),i+1,OS_OPT_POST_FIFO,&err);
+        if(err != OS_ERR_NONE)
+        {
+            rt_kprintf("queue_static_test: post %d err:%d!\r\n",i,err);
+            fail = 1;
+        }
+    }
+    OSQPost(&static_q,(void*)0,0,OS_OPT_POST_FIFO,&err);/**/
+    if(err != OS_ERR_Q_MAX)
+    {
+        rt_kprintf("queue_static_test: post to full queue err:%d, expect OS_ERR_Q_MAX!\r\n",err);
+        fail = 1;
+    }
+    if(OSMsgPool.NbrFree != pool_free)
+    {
+        rt_kprintf("queue_static_test: global message pool was used!\r\n");
+        fail = 1;
+    }
+
+    for(i=0;i<DATAMSG_Q_NUM;i++)/*FIFO˳ȡ*/
+    {
+        p = OSQPend(&static_q,0,OS_OPT_PEND_NON_BLOCKING,&size,0,&err);
+        if(err != OS_ERR_NONE || p != (void*)(i+1) || size != i+1)
+        {
+            rt_kprintf("queue_static_test: pend %d err:%d msg:%d!\r\n",i,err,(int)p);
+            fail = 1;
+        }
+    }
+    OSQDel(&static_q,OS_OPT_DEL_ALWAYS,&err);
+    rt_kprintf("queue_static_test %s\r\n",fail ? "fail" : "pass");
+}
+#endif
@@ -0,0 +1,404 @@
+#include <os.h>
+
+#define THREAD_PRIORITY         5
+#define THREAD_STACK_SIZE       512
+#define THREAD_TIMESLICE        5
+
+#define SPIN_TICKS              20      //ȼÿռCPUtick
+
+static OS_TCB   bg_tcb;                 //̨,ʼʱȼȼ,֮󱻽
+static CPU_STK  bg_stack[THREAD_STACK_SIZE/sizeof(CPU_STK)];
+
+ALIGN(RT_ALIGN_SIZE)
+static char thread_mid_stack[1024];
+static struct rt_thread thread_mid;
+
+static volatile rt_uint32_t bg_cnt;    //̨д
+
+/* ̨:ÿtickһ */
+static void bg_entry(void *param)
+{
+    OS_ERR err;
+    
+    while(1)
+    {
+        bg_cnt++;
+        OSTimeDly(1,OS_OPT_TIME_DLY,&err);
+    }
+}
+
+/* ռCPU SPIN_TICKStick,ڼ̨еĴ */
+static rt_uint32_t spin(void)
+{
+    rt_uint32_t cnt = bg_cnt;
+    rt_tick_t start = rt_tick_get();
+    
+    while(rt_tick_get() - start < SPIN_TICKS);
+    return bg_cnt - cnt;
+}
+
+/* ȼ */
+static void thread_mid_entry(void *param)
+{
+    OS_ERR err;
+    rt_uint32_t cnt;
+    
+    cnt = spin();
+    rt_kprintf("bg prio %d: bg ran %d times while mid was busy\r\n",bg_tcb.Task.current_priority,cnt);
+    
+    OSTaskChangePrio(&bg_tcb,THREAD_PRIORITY,&err);//̨񽵼ȼ֮
+    if(err != OS_ERR_NONE)
+    {
+        rt_kprintf("change prio err:%d\r\n",err);
+    }
+    
+    cnt = spin();
+    rt_kprintf("bg prio %d: bg ran %d times while mid was busy\r\n",bg_tcb.Task.current_priority,cnt);
+    if(cnt == 0)
+    {
+        rt_kprintf("task_test pass: demoted task no longer preempts\r\n");
+    }
+    else
+    {
+        rt_kprintf("task_test fail!\r\n");
+    }
+    
+    OSTaskDel(&bg_tcb,&err);
+}
+
+void task_test (void)
+{
+    OS_ERR err;
+    
+    OSTaskCreate(&bg_tcb,		            //ƿ
+			   (CPU_CHAR*)"bg", 		    //
+               bg_entry, 			        //
+               0,					        //ݸĲ
+               THREAD_PRIORITY-2,           //ȼ
+               bg_stack,	                //ջַ
+               sizeof(bg_stack)/sizeof(CPU_STK)/10,//ջλ
+               sizeof(bg_stack)/sizeof(CPU_STK),   //ջС
+               0,					        //ڲϢܹյϢĿ,Ϊ0ʱֹϢ
+               THREAD_TIMESLICE,			//ʹʱƬתʱʱƬȣΪ0ʱΪĬϳ
+               0,					        //ûĴ洢
+               OS_OPT_TASK_NONE,            //ѡ
+               &err);
+    if(err != OS_ERR_NONE)
+    {
+        rt_kprintf("create err!\r\n");
+    }
+    
+    rt_thread_init(&thread_mid,
+                   "thread_mid",
+                   thread_mid_entry,
+                   RT_NULL,
+                   &thread_mid_stack[0],
+                   sizeof(thread_mid_stack),
+                   THREAD_PRIORITY - 1, THREAD_TIMESLICE);
+    rt_thread_startup(&thread_mid);
+}
+
+/* ----------------------------------------- ջλ(stk_limit) ----------------------------------------- */
+
+#define STK_TASK_SIZE           256     //CPU_STKΪλ
+#define STK_TASK_LIMIT          (STK_TASK_SIZE/2)   //ջõһͱ
+
+static OS_TCB   stk_tcb;
+static CPU_STK  stk_stack[STK_TASK_SIZE];
+
+static volatile rt_uint32_t stk_hit;    //ӱõĴ
+
+/* ڵб,ܴӡ,ֻ */
+static void stk_limit_hook(OS_TCB *p_tcb)
+{
+    if(p_tcb == &stk_tcb)
+    {
+        stk_hit++;
+    }
+}
+
+/* ݹdepthʱ,ʹڶջʱлȥ */
+static void stk_deep(int depth)
+{
+    OS_ERR err;
+    volatile CPU_STK buf[16];
+    
+    buf[0] = depth;
+    if(depth > 0)
+    {
+        stk_deep(depth-1);
+    }
+    else
+    {
+        OSTimeDly(1,OS_OPT_TIME_DLY,&err);
+    }
+    (void)buf[0];
+}
+
+static void stk_entry(void *param)
+{
+    OS_ERR err;
+    CPU_STK_SIZE free, used, used_max;
+    int depth;
+    
+    for(depth=1;depth<=10;depth++)
+    {
+        stk_deep(depth);
+        OSTaskStkChk(RT_NULL,&free,&used,&used_max,&err);
+        rt_kprintf("depth:%2d  used max:%3d/%d  limit hook called:%d\r\n",depth,used_max,STK_TASK_SIZE,stk_hit);
+        if(stk_hit > 0)
+        {
+            rt_kprintf("stk_limit_test pass: stack limit %d crossed\r\n",STK_TASK_LIMIT);
+            return;
+        }
+    }
+    rt_kprintf("stk_limit_test fail!\r\n");
+}
+
+void stk_limit_test (void)
+{
+    OS_ERR err;
+    
+    stk_hit = 0;
+    OS_AppStkLimitHookPtr = stk_limit_hook;
+    
+    OSTaskCreate(&stk_tcb,
+			   (CPU_CHAR*)"stk",
+               stk_entry,
+               0,
+               THREAD_PRIORITY-1,
+               stk_stack,
+               STK_TASK_LIMIT,              //ջλ
+               STK_TASK_SIZE,
+               0,
+               THREAD_TIMESLICE,
+               0,
+               OS_OPT_TASK_STK_CHK,
+               &err);
+    if(err != OS_ERR_NONE)
+    {
+        rt_kprintf("create err:%d\r\n",err);
+        return;
+    }
+    
+    /* λôRTTջײ(TLS۱֮) */
+    if(stk_tcb.StkLimitPtr != (CPU_STK *)stk_tcb.Task.stack_addr + STK_TASK_LIMIT)
+    {
+        rt_kprintf("stk_limit_test fail: limit is not above the TLS table\r\n");
+    }
+}
+
+/* --------------------------------------------- CPUʹͳƲ --------------------------------------------- */
+
+#define LOAD_BUSY_TICKS         30      //ÿռCPUtick
+#define LOAD_IDLE_TICKS         70      //ÿʱtick,ԼΪ30%
+
+static OS_TCB   load_tcb;
+static CPU_STK  load_stack[THREAD_STACK_SIZE/sizeof(CPU_STK)];
+
+static OS_TCB   report_tcb;
+static CPU_STK  report_stack[THREAD_STACK_SIZE/sizeof(CPU_STK)];
+
+static void load_entry(void *param)
+{
+    OS_ERR err;
+    rt_tick_t start;
+    
+    while(1)
+    {
+        start = rt_tick_get();
+        while(rt_tick_get() - start < LOAD_BUSY_TICKS);
+        OSTimeDly(LOAD_IDLE_TICKS,OS_OPT_TIME_DLY,&err);
+    }
+}
+
+static void report_entry(void *param)
+{
+    OS_ERR err;
+    int i;
+    
+    for(i=0;i<5;i++)
+    {
+        OSTimeDly(RT_TICK_PER_SECOND,OS_OPT_TIME_DLY,&err);
+        rt_kprintf("cpu:%d.%02d%% (max %d.%02d%%)  load task:%d.%02d%%  ctx sw:%d\r\n",
+                   OSStatTaskCPUUsage/100,OSStatTaskCPUUsage%100,
+                   OSStatTaskCPUUsageMax/100,OSStatTaskCPUUsageMax%100,
+                   load_tcb.CPUUsage/100,load_tcb.CPUUsage%100,
+                   load_tcb.CtxSwCtr);
+    }
+    OSStatReset(&err);
+    rt_kprintf("after reset, max:%d.%02d%%\r\n",OSStatTaskCPUUsageMax/100,OSStatTaskCPUUsageMax%100);
+    OSTaskDel(&load_tcb,&err);
+}
+
+void stat_test (void)
+{
+    OS_ERR err;
+    
+    OSStatTaskCPUUsageInit(&err);//ڴ֮ǰ궨м
+    if(err != OS_ERR_NONE)
+    {
+        rt_kprintf("cpu usage init err:%d\r\n",err);
+        return;
+    }
+    rt_kprintf("idle counter max:%d\r\n",OSStatTaskCtrMax);
+    
+    OSTaskCreate(&load_tcb,
+			   (CPU_CHAR*)"load",
+               load_entry,
+               0,
+               THREAD_PRIORITY,
+               load_stack,
+               sizeof(load_stack)/sizeof(CPU_STK)/10,
+               sizeof(load_stack)/sizeof(CPU_STK),
+               0,
+               THREAD_TIMESLICE,
+               0,
+               OS_OPT_TASK_NONE,
+               &err);
+    OSTaskCreate(&report_tcb,
+			   (CPU_CHAR*)"report",
+               report_entry,
+               0,
+               THREAD_PRIORITY-1,
+               report_stack,
+               sizeof(report_stack)/sizeof(CPU_STK)/10,
+               sizeof(report_stack)/sizeof(CPU_STK),
+               0,
+               THREAD_TIMESLICE,
+               0,
+               OS_OPT_TASK_NONE,
+               &err);
+    if(err != OS_ERR_NONE)
+    {
+        rt_kprintf("create err:%d\r\n",err);
+    }
+}
+
+/* ------------------------------------------------ TLS ------------------------------------------------ */
+
+static OS_TCB   tls_tcb;
+static CPU_STK  tls_stack[THREAD_STACK_SIZE/sizeof(CPU_STK)];
+
+static OS_TCB   no_tls_tcb;
+static CPU_STK  no_tls_stack[THREAD_STACK_SIZE/sizeof(CPU_STK)];
+
+static OS_TLS_ID tls_id;
+static volatile rt_uint32_t tls_destructed;
+
+/* ɾʱ,valueΪTLSֵ */
+static void tls_destruct(OS_TCB *p_tcb, OS_TLS_ID id, OS_TLS value)
+{
+    tls_destructed = (rt_uint32_t)value;
+}
+
+static void tls_entry(void *param)
+{
+    OS_ERR err;
+    
+    OS_TLS_SetValue(RT_NULL,tls_id,param,&err);//ÿ񱣴Եֵ
+    while(1)
+    {
+        OSTimeDly(10,OS_OPT_TIME_DLY,&err);
+    }
+}
+
+/* Ϻ󷵻ص:ʱҲӦ,ڽϢеϢ黹Ϣ */
+static void tls_return_entry(void *param)
+{
+    OS_ERR err;
+    
+    OS_TLS_SetValue(RT_NULL,tls_id,param,&err);
+    OSTaskQPost(RT_NULL,(void*)1,1,OS_OPT_POST_FIFO,&err);
+    OSTaskQPost(RT_NULL,(void*)2,2,OS_OPT_POST_FIFO,&err);
+}
+
+void tls_test (void)
+{
+    OS_ERR err;
+    OS_TLS value;
+    OS_MSG_QTY pool_free;
+    
+    tls_id = OS_TLS_GetID(&err);
+    OS_TLS_SetDestruct(tls_id,tls_destruct,&err);
+    
+    OSTaskCreate(&tls_tcb,(CPU_CHAR*)"tls",tls_entry,(void*)0x1234,THREAD_PRIORITY,
+                 tls_stack,0,sizeof(tls_stack)/sizeof(CPU_STK),0,THREAD_TIMESLICE,0,
+                 OS_OPT_TASK_NONE,&err);
+    OSTaskCreate(&no_tls_tcb,(CPU_CHAR*)"no_tls",tls_entry,(void*)0x5678,THREAD_PRIORITY,
+                 no_tls_stack,0,sizeof(no_tls_stack)/sizeof(CPU_STK),0,THREAD_TIMESLICE,0,
+                 OS_OPT_TASK_NO_TLS,&err);//ҪTLS,ջ
+    OSTimeDly(20,OS_OPT_TIME_DLY,&err);
+    
+    value = OS_TLS_GetValue(&tls_tcb,tls_id,&err);
+    rt_kprintf("tls task value:0x%x err:%d\r\n",(rt_uint32_t)value,err);
+    value = OS_TLS_GetValue(&no_tls_tcb,tls_id,&err);
+    rt_kprintf("no_tls task err:%d (OS_ERR_TLS_NOT_EN:%d)\r\n",err,OS_ERR_TLS_NOT_EN);
+    
+    OSTaskDel(&tls_tcb,&err);
+    OSTaskDel(&no_tls_tcb,&err);
+    if(tls_destructed == 0x1234)
+    {
+        rt_kprintf("tls_test pass: destructor called with 0x%x\r\n",tls_destructed);
+    }
+    else
+    {
+        rt_kprintf("tls_test fail!\r\n");
+    }
+    
+    tls_destructed = 0;
+    pool_free = OSMsgPool.NbrFree;
+    OSTaskCreate(&tls_tcb,(CPU_CHAR*)"tls_ret",tls_return_entry,(void*)0xABCD,THREAD_PRIORITY,
+                 tls_stack,0,sizeof(tls_stack)/sizeof(CPU_STK),4,THREAD_TIMESLICE,0,
+                 OS_OPT_TASK_NONE,&err);
+    OSTimeDly(20,OS_OPT_TIME_DLY,&err);
+    if(tls_destructed == 0xABCD && OSMsgPool.NbrFree == pool_free)
+    {
+        rt_kprintf("tls_test pass: task return released TLS and messages\r\n");
+    }
+    else
+    {
+        rt_kprintf("tls_test fail: task return, destructor:0x%x pool free:%d/%d\r\n",
+                   tls_destructed,OSMsgPool.NbrFree,pool_free);
+    }
+}
+
+/* -------------------------------------------- ʱǰѲ -------------------------------------------- */
+
+static OS_TCB   dly_tcb;
+static CPU_STK  dly_stack[THREAD_STACK_SIZE/sizeof(CPU_STK)];
+
+static void dly_entry(void *param)
+{
+    OS_ERR err;
+    OS_TICK tick;
+    
+    while(1)
+    {
+        tick = OSTimeGet(&err);
+        OSTimeDly(1000,OS_OPT_TIME_DLY,&err);
+        rt_kprintf("dly task woke after %d ticks\r\n",OSTimeGet(&err)-tick);
+    }
+}
+
+void dly_resume_test (void)
+{
+    OS_ERR err;
+    
+    OSTaskCreate(&dly_tcb,(CPU_CHAR*)"dly",dly_entry,0,THREAD_PRIORITY,
+                 dly_stack,0,sizeof(dly_stack)/sizeof(CPU_STK),0,THREAD_TIMESLICE,0,
+                 OS_OPT_TASK_NONE,&err);
+    OSTimeDly(10,OS_OPT_TIME_DLY,&err);
+    
+    OSTimeDlyResume(&dly_tcb,&err);//Լ10tick󱻻
+    rt_kprintf("resume delayed task err:%d\r\n",err);
+    
+    OSTimeDly(10,OS_OPT_TIME_DLY,&err);
+    OSTaskSuspend(&dly_tcb,&err);
+    OSTimeDlyResume(&dly_tcb,&err);//ʱȡ,Աֹ
+    rt_kprintf("resume suspended task err:%d (OS_ERR_TASK_SUSPENDED:%d)\r\n",err,OS_ERR_TASK_SUSPENDED);
+    OSTimeDlyResume(&dly_tcb,&err);
+    rt_kprintf("resume again err:%d (OS_ERR_TASK_NOT_DLY:%d)\r\n",err,OS_ERR_TASK_NOT_DLY);
+    
+    OSTaskResume(&dly_tcb,&err);//Լ20tick󱻻
+}
@@ -209,6 +209,42 @@ typedef  rt_base_t                  CPU_SR;                     /* Defines   CPU
 #define  CPU_CRITICAL_EXIT()   do { CPU_INT_EN();  } while (0)          /* Re-enable interrupts.                        */
 
 
+/*
+*********************************************************************************************************
+*                                           MEMORY BARRIER
+*
+* Note(s) : (1) CPU_MB() ֤֮ǰĴ洢֮Ĵ洢(Cortex-M3ΪDMBָ),
+*               ͬʱֹԽõŷ,ݲвжϵݽṹʹ
+*********************************************************************************************************
+*/
+
+#if   defined(__CC_ARM)                                         /* Keil ARMCC V5                                        */
+#define  CPU_MB()              __dmb(0xF)
+#elif defined(__ICCARM__)                                       /* IAR                                                  */
+#define  CPU_MB()              __asm volatile ("DMB")
+#else                                                           /* GCC / ARMCC V6                                       */
+#define  CPU_MB()              __sync_synchronize()
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      TIMESTAMP TIMER CONFIGURATION
+*
+* Note(s) : (1) ʱʱʹCortex-M3DWTڼ(DWT_CYCCNT),ƵʵCPUƵ,32λ,
+*               ζ֮(޷ż)ΪCPU,72MHzԼ59.6һ
+*           (2) CPU_TS_Get64()ۼ32λչΪ64λ,ҪڼһȦ֮ٵһ
+*               CPU_TS_Get64()CPU_TS_Update(),ݲOSInit()дڵCPU_TS_Update()Ķʱ
+*           (3) CPU˯(WFI)ʱDWT_CYCCNTֹͣ,ʱ˯ߵʱ
+*********************************************************************************************************
+*/
+
+typedef  CPU_INT32U                 CPU_TS_TMR;                 /* Timestamp timer size.                                */
+
+typedef  CPU_INT32U                 CPU_TS32;                   /* 32-bit timestamp.                                    */
+typedef  CPU_INT64U                 CPU_TS64;                   /* 64-bit timestamp (see Note #2).                      */
+
+
 /*
 *********************************************************************************************************
 *                                         FUNCTION PROTOTYPES
@@ -229,6 +265,13 @@ typedef  rt_base_t                  CPU_SR;                     /* Defines   CPU
 CPU_SR      CPU_SR_Save      (void);
 void        CPU_SR_Restore   (CPU_SR      cpu_sr);
 
+void        CPU_TS_TmrInit   (void);
+CPU_TS_TMR  CPU_TS_TmrRd     (void);
+
+CPU_TS32    CPU_TS_Get32     (void);
+CPU_TS64    CPU_TS_Get64     (void);
+void        CPU_TS_Update    (void);
+
 
 //void        CPU_WaitForInt   (void);
 //void        CPU_WaitForExcept(void);
@@ -71,3 +71,78 @@ void CPU_SR_Restore (CPU_SR cpu_sr)
 {
     rt_hw_interrupt_enable(cpu_sr);
 }
+
+/*
+;********************************************************************************************************
+;                                        TIMESTAMP TIMER FUNCTIONS
+;
+; Description : Initialize & read the timestamp timer, which is the DWT cycle counter of the Cortex-M3.
+;
+; Prototypes  : void        CPU_TS_TmrInit(void);
+;               CPU_TS_TMR  CPU_TS_TmrRd  (void);
+;
+; Note(s)     : (1) CPU_TS_TmrInit()DWTڼ,ظ;ʱҲѾ
+;********************************************************************************************************
+*/
+
+#define  CPU_REG_DEM_CR         (*(CPU_REG32 *)0xE000EDFCu)     /* Debug Exception and Monitor Control Register         */
+#define  CPU_REG_DWT_CR         (*(CPU_REG32 *)0xE0001000u)     /* DWT Control Register                                 */
+#define  CPU_REG_DWT_CYCCNT     (*(CPU_REG32 *)0xE0001004u)     /* DWT Cycle Count Register                             */
+
+#define  CPU_BIT_DEM_CR_TRCENA              (1u << 24)
+#define  CPU_BIT_DWT_CR_CYCCNTENA           (1u <<  0)
+
+void CPU_TS_TmrInit (void)
+{
+    CPU_REG_DEM_CR |= CPU_BIT_DEM_CR_TRCENA;
+    CPU_REG_DWT_CR |= CPU_BIT_DWT_CR_CYCCNTENA;
+}
+
+CPU_TS_TMR CPU_TS_TmrRd (void)
+{
+    return (CPU_TS_TMR)CPU_REG_DWT_CYCCNT;
+}
+
+/*
+;********************************************************************************************************
+;                                          TIMESTAMP FUNCTIONS
+;
+; Description : Get the current 32-bit or 64-bit CPU timestamp (in CPU cycles).
+;
+; Prototypes  : CPU_TS32  CPU_TS_Get32 (void);
+;               CPU_TS64  CPU_TS_Get64 (void);
+;               void      CPU_TS_Update(void);
+;
+; Note(s)     : (1) 64λʱһζļֵۼֵչõ,cpu.hTIMESTAMP TIMER CONFIGURATION
+;                   Note #2.CPU_TS_Update()û˶ȡ64λʱʱֹʧĻ
+;********************************************************************************************************
+*/
+
+static  CPU_TS_TMR  CPU_TS_64_TmrPrev;                          /* һζļֵ                                   */
+static  CPU_TS64    CPU_TS_64_Accum;                            /* ۼӵ64λʱ                                     */
+
+CPU_TS32 CPU_TS_Get32 (void)
+{
+    return (CPU_TS32)CPU_TS_TmrRd();
+}
+
+CPU_TS64 CPU_TS_Get64 (void)
+{
+    CPU_TS_TMR  tmr_cur;
+    CPU_TS64    ts;
+    CPU_SR_ALLOC();
+
+    CPU_INT_DIS();
+    tmr_cur            = CPU_TS_TmrRd();
+    CPU_TS_64_Accum   += (CPU_TS_TMR)(tmr_cur - CPU_TS_64_TmrPrev);
+    CPU_TS_64_TmrPrev  = tmr_cur;
+    ts                 = CPU_TS_64_Accum;
+    CPU_INT_EN();
+
+    return ts;
+}
+
+void CPU_TS_Update (void)
+{
+    (void)CPU_TS_Get64();
+}
@@ -72,6 +72,16 @@
 ************************************************************************************************************************
 */
 
+/*
+========================================================================================================================
+*                                                      TIMESTAMP
+*
+* Note(s) : ʱΪDWTڼļֵ(CPU),ʱ֮(޷ż)ΪCPU
+========================================================================================================================
+*/
+
+#define  OS_TS_GET()                         (CPU_TS)CPU_TS_TmrRd()
+
 /*
 ========================================================================================================================
 *                                           Possible values for 'opt' argument
@@ -114,6 +124,15 @@
 #define  OS_OPT_PEND_BLOCKING                (OS_OPT)(0x0000u)
 #define  OS_OPT_PEND_NON_BLOCKING            (OS_OPT)(0x8000u)
 
+/*
+------------------------------------------------------------------------------------------------------------------------
+*                                                PEND ABORT OPTIONS
+------------------------------------------------------------------------------------------------------------------------
+*/
+
+#define  OS_OPT_PEND_ABORT_1                 (OS_OPT)(0x0000u)  /* Pend abort a single waiting task                   */
+#define  OS_OPT_PEND_ABORT_ALL               (OS_OPT)(0x0100u)  /* Pend abort ALL tasks waiting                       */
+
 /*
 ------------------------------------------------------------------------------------------------------------------------
 *                                                     POST OPTIONS
@@ -169,6 +188,8 @@
                                                       OS_OPT_TIME_MATCH          | \
                                                       OS_OPT_TIME_HMSM_NON_STRICT)
 
+#define  OS_TIME_DLY_MAX                     ((OS_TICK)(RT_TICK_MAX / 2u - 1u))  /* RTTζʱ(tick)         */
+
 /*
 ------------------------------------------------------------------------------------------------------------------------
 *                                                    TIMER OPTIONS
@@ -183,6 +204,40 @@
 #define  OS_OPT_TMR_CALLBACK                      (OS_OPT)(3u)  /* OSTmrStop() option to call 'callback' w/ timer arg */
 #define  OS_OPT_TMR_CALLBACK_ARG                  (OS_OPT)(4u)  /* OSTmrStop() option to call 'callback' w/ new   arg */
 
+/*
+========================================================================================================================
+*                                                   PEND STATUS
+========================================================================================================================
+*/
+
+#define  OS_STATUS_PEND_OK                   (OS_STATUS)(  0u)  /* Pending status OK, !pending, or pending complete    */
+#define  OS_STATUS_PEND_ABORT                (OS_STATUS)(  1u)  /* Pending aborted                                     */
+#define  OS_STATUS_PEND_DEL                  (OS_STATUS)(  2u)  /* Pending object deleted                              */
+#define  OS_STATUS_PEND_TIMEOUT              (OS_STATUS)(  3u)  /* Pending timed out                                   */
+
+/*
+========================================================================================================================
+*                                                   TASK PEND ON ...
+========================================================================================================================
+*/
+
+#define  OS_TASK_PEND_ON_NOTHING              (OS_STATE)(  0u)  /* Pending on nothing                                  */
+#define  OS_TASK_PEND_ON_TASK_Q               (OS_STATE)(  2u)  /* Pending on message to be sent to task               */
+#define  OS_TASK_PEND_ON_TASK_SEM             (OS_STATE)(  7u)  /* Pending on signal  to be sent to task               */
+
+/*
+========================================================================================================================
+*                                                     TASK STATES
+*
+* Note(s) : ֻ¼OSTimeDly()ʱOSTaskSuspend()Ĺ,ȴں˶ΪOS_TASK_STATE_RDY
+========================================================================================================================
+*/
+
+#define  OS_TASK_STATE_RDY                    (OS_STATE)(  0u)  /*   0 0 0     Ready                                   */
+#define  OS_TASK_STATE_DLY                    (OS_STATE)(  1u)  /*   0 0 1     Delayed or Timeout                      */
+#define  OS_TASK_STATE_SUSPENDED              (OS_STATE)(  4u)  /*   1 0 0     Suspended                               */
+#define  OS_TASK_STATE_DLY_SUSPENDED          (OS_STATE)(  5u)  /*   1 0 1     Suspended + Delayed or Timeout          */
+
 
 /*
 ************************************************************************************************************************
@@ -220,7 +275,7 @@ typedef  enum  os_err {
 //    OS_ERR_FLAG_GRP_DEPLETED         = 15101u,
 //    OS_ERR_FLAG_NOT_RDY              = 15102u,
 //    OS_ERR_FLAG_PEND_OPT             = 15103u,
-//    OS_ERR_FLUSH_ISR                 = 15104u,
+    OS_ERR_FLUSH_ISR                 = 15104u,
 
     OS_ERR_G                         = 16000u,
 
@@ -229,8 +284,8 @@ typedef  enum  os_err {
     OS_ERR_I                         = 18000u,
 //    OS_ERR_ILLEGAL_CREATE_RUN_TIME   = 18001u,
 //    OS_ERR_INT_Q                     = 18002u,
-//    OS_ERR_INT_Q_FULL                = 18003u,
-//    OS_ERR_INT_Q_SIZE                = 18004u,
+    OS_ERR_INT_Q_FULL                = 18003u,
+    OS_ERR_INT_Q_SIZE                = 18004u,
 //    OS_ERR_INT_Q_STK_INVALID         = 18005u,
 //    OS_ERR_INT_Q_STK_SIZE_INVALID    = 18006u,
 
@@ -254,8 +309,8 @@ typedef  enum  os_err {
 //    OS_ERR_MEM_INVALID_SIZE          = 22209u,
 //    OS_ERR_MEM_NO_FREE_BLKS          = 22210u,
 
-//    OS_ERR_MSG_POOL_EMPTY            = 22301u,
-//    OS_ERR_MSG_POOL_NULL_PTR         = 22302u,
+    OS_ERR_MSG_POOL_EMPTY            = 22301u,
+    OS_ERR_MSG_POOL_NULL_PTR         = 22302u,
 
     OS_ERR_MUTEX_NOT_OWNER           = 22401u,
 //    OS_ERR_MUTEX_OWNER               = 22402u,
@@ -263,11 +318,11 @@ typedef  enum  os_err {
 
     OS_ERR_N                         = 23000u,
     OS_ERR_NAME                      = 23001u,
-//    OS_ERR_NO_MORE_ID_AVAIL          = 23002u,
+    OS_ERR_NO_MORE_ID_AVAIL          = 23002u,
 
     OS_ERR_O                         = 24000u,
     OS_ERR_OBJ_CREATED               = 24001u,
-//    OS_ERR_OBJ_DEL                   = 24002u,
+    OS_ERR_OBJ_DEL                   = 24002u,
     OS_ERR_OBJ_PTR_NULL              = 24003u,
     OS_ERR_OBJ_TYPE                  = 24004u,
 
@@ -277,14 +332,14 @@ typedef  enum  os_err {
 //    OS_ERR_OS_RUNNING                = 24202u,
 
     OS_ERR_P                         = 25000u,
-//    OS_ERR_PEND_ABORT                = 25001u,
-//    OS_ERR_PEND_ABORT_ISR            = 25002u,
-//    OS_ERR_PEND_ABORT_NONE           = 25003u,
-//    OS_ERR_PEND_ABORT_SELF           = 25004u,
+    OS_ERR_PEND_ABORT                = 25001u,
+    OS_ERR_PEND_ABORT_ISR            = 25002u,
+    OS_ERR_PEND_ABORT_NONE           = 25003u,
+    OS_ERR_PEND_ABORT_SELF           = 25004u,
 //    OS_ERR_PEND_DEL                  = 25005u,
     OS_ERR_PEND_ISR                  = 25006u,
 //    OS_ERR_PEND_LOCKED               = 25007u,
-//    OS_ERR_PEND_WOULD_BLOCK          = 25008u,
+    OS_ERR_PEND_WOULD_BLOCK          = 25008u,
 
 //    OS_ERR_POST_NULL_PTR             = 25101u,
     OS_ERR_POST_ISR                  = 25102u,
@@ -297,14 +352,14 @@ typedef  enum  os_err {
 
     OS_ERR_Q                         = 26000u,
 //    OS_ERR_Q_FULL                    = 26001u,
-//    OS_ERR_Q_EMPTY                   = 26002u,
+    OS_ERR_Q_EMPTY                   = 26002u,
     OS_ERR_Q_MAX                     = 26003u,
     OS_ERR_Q_SIZE                    = 26004u,
 
     OS_ERR_R                         = 27000u,
-//    OS_ERR_REG_ID_INVALID            = 27001u,
+    OS_ERR_REG_ID_INVALID            = 27001u,
 //    OS_ERR_ROUND_ROBIN_1             = 27002u,
-//    OS_ERR_ROUND_ROBIN_DISABLED      = 27003u,
+    OS_ERR_ROUND_ROBIN_DISABLED      = 27003u,
 
     OS_ERR_S                         = 28000u,
 //    OS_ERR_SCHED_INVALID_TIME_SLICE  = 28001u,
@@ -313,21 +368,21 @@ typedef  enum  os_err {
     OS_ERR_SCHED_NOT_LOCKED          = 28004u,
     OS_ERR_SCHED_UNLOCK_ISR          = 28005u,
 
-//    OS_ERR_SEM_OVF                   = 28101u,
-//    OS_ERR_SET_ISR                   = 28102u,
+    OS_ERR_SEM_OVF                   = 28101u,
+    OS_ERR_SET_ISR                   = 28102u,
 
-//    OS_ERR_STAT_RESET_ISR            = 28201u,
-//    OS_ERR_STAT_PRIO_INVALID         = 28202u,
+    OS_ERR_STAT_RESET_ISR            = 28201u,
+    OS_ERR_STAT_PRIO_INVALID         = 28202u,
 //    OS_ERR_STAT_STK_INVALID          = 28203u,
 //    OS_ERR_STAT_STK_SIZE_INVALID     = 28204u,
-//    OS_ERR_STATE_INVALID             = 28205u,
+    OS_ERR_STATE_INVALID             = 28205u,
 //    OS_ERR_STATUS_INVALID            = 28206u,
     OS_ERR_STK_INVALID               = 28207u,
     OS_ERR_STK_SIZE_INVALID          = 28208u,
-//    OS_ERR_STK_LIMIT_INVALID         = 28209u,
+    OS_ERR_STK_LIMIT_INVALID         = 28209u,
 
     OS_ERR_T                         = 29000u,
-//    OS_ERR_TASK_CHANGE_PRIO_ISR      = 29001u,
+    OS_ERR_TASK_CHANGE_PRIO_ISR      = 29001u,
     OS_ERR_TASK_CREATE_ISR           = 29002u,
 //    OS_ERR_TASK_DEL                  = 29003u,
 //    OS_ERR_TASK_DEL_IDLE             = 29004u,
@@ -335,7 +390,7 @@ typedef  enum  os_err {
     OS_ERR_TASK_DEL_ISR              = 29006u,
     OS_ERR_TASK_INVALID              = 29007u,
 //    OS_ERR_TASK_NO_MORE_TCB          = 29008u,
-//    OS_ERR_TASK_NOT_DLY              = 29009u,
+    OS_ERR_TASK_NOT_DLY              = 29009u,
     OS_ERR_TASK_NOT_EXIST            = 29010u,
     OS_ERR_TASK_NOT_SUSPENDED        = 29011u,
 //    OS_ERR_TASK_OPT                  = 29012u,
@@ -344,20 +399,20 @@ typedef  enum  os_err {
     OS_ERR_TASK_RESUME_SELF          = 29015u,
 //    OS_ERR_TASK_RUNNING              = 29016u,
     OS_ERR_TASK_STK_CHK_ISR          = 29017u,
-//    OS_ERR_TASK_SUSPENDED            = 29018u,
+    OS_ERR_TASK_SUSPENDED            = 29018u,
 //    OS_ERR_TASK_SUSPEND_IDLE         = 29019u,
 //    OS_ERR_TASK_SUSPEND_INT_HANDLER  = 29020u,
     OS_ERR_TASK_SUSPEND_ISR          = 29021u,
 //    OS_ERR_TASK_SUSPEND_PRIO         = 29022u,
-//    OS_ERR_TASK_WAITING              = 29023u,
+    OS_ERR_TASK_WAITING              = 29023u,
 
     OS_ERR_TCB_INVALID               = 29101u,
 
-//    OS_ERR_TLS_ID_INVALID            = 29120u,
+    OS_ERR_TLS_ID_INVALID            = 29120u,
 //    OS_ERR_TLS_ISR                   = 29121u,
-//    OS_ERR_TLS_NO_MORE_AVAIL         = 29122u,
-//    OS_ERR_TLS_NOT_EN                = 29123u,
-//    OS_ERR_TLS_DESTRUCT_ASSIGNED     = 29124u,
+    OS_ERR_TLS_NO_MORE_AVAIL         = 29122u,
+    OS_ERR_TLS_NOT_EN                = 29123u,
+    OS_ERR_TLS_DESTRUCT_ASSIGNED     = 29124u,
 
 //    OS_ERR_TICK_PRIO_INVALID         = 29201u,
 //    OS_ERR_TICK_STK_INVALID          = 29202u,
@@ -365,13 +420,13 @@ typedef  enum  os_err {
 //    OS_ERR_TICK_WHEEL_SIZE           = 29204u,
 
     OS_ERR_TIME_DLY_ISR              = 29301u,
-//    OS_ERR_TIME_DLY_RESUME_ISR       = 29302u,
+    OS_ERR_TIME_DLY_RESUME_ISR       = 29302u,
 //    OS_ERR_TIME_GET_ISR              = 29303u,
     OS_ERR_TIME_INVALID_HOURS        = 29304u,
     OS_ERR_TIME_INVALID_MINUTES      = 29305u,
     OS_ERR_TIME_INVALID_SECONDS      = 29306u,
     OS_ERR_TIME_INVALID_MILLISECONDS = 29307u,
-//    OS_ERR_TIME_NOT_DLY              = 29308u,
+    OS_ERR_TIME_NOT_DLY              = 29308u,
 //    OS_ERR_TIME_SET_ISR              = 29309u,
     OS_ERR_TIME_ZERO_DLY             = 29310u,
 
@@ -428,32 +483,241 @@ typedef  enum  os_err {
 ************************************************************************************************************************
 ************************************************************************************************************************
 */
+/*
+------------------------------------------------------------------------------------------------------------------------
+*                                                  PEND DATA / PEND LIST
+*
+* Note(s) : ݲйں˶(Ϣ)ʹRTTIPC,ʹðȼеĵȴб
+*           OS_PEND_DATAɵȴԼĶջϷ䲢ȴб,ͶݷֱӽϢдк,
+*           ϢҪл
+------------------------------------------------------------------------------------------------------------------------
+*/
+typedef  struct  os_pend_data        OS_PEND_DATA;
+
+typedef  struct  os_pend_list        OS_PEND_LIST;
+
+struct  os_pend_data
+{
+    rt_list_t            List;/*ȴбĽڵ*/
+    struct  rt_thread   *TCBPtr;/*ڵȴ*/
+    void                *MsgPtr;/*ͶݷϢָ*/
+    OS_MSG_SIZE          MsgSize;/*ͶݷϢ*/
+    CPU_TS               TS;/*Ͷݡֹȴɾʱʱ*/
+    OS_STATUS            PendStatus;/*ȴ*/
+};
+
+struct  os_pend_list
+{
+    rt_list_t            List;/*ȴбͷ,ȼɸߵ*/
+    OS_OBJ_QTY           NbrEntries;/*ڵȴ*/
+};
+
+/*
+------------------------------------------------------------------------------------------------------------------------
+*                                                      MESSAGES
+*
+* Note(s) : ϢĬϹһȫֵϢOSMsgPool,СOS_CFG_MSG_POOL_SIZE̬,ռڴ
+*           ͨOSQCreateStatic()Ϣʹõ÷ṩOS_MSGΪԼ˽Ϣ
+*           ϢеĿϢԵʽ֯,ȡ͹黹ΪO(1)
+------------------------------------------------------------------------------------------------------------------------
+*/
+typedef  struct  os_msg              OS_MSG;
+
+typedef  struct  os_msg_pool         OS_MSG_POOL;
+
+typedef  struct  os_msg_q            OS_MSG_Q;
+
+struct  os_msg                                              /* MESSAGE CONTROL BLOCK                                  */
+{
+    OS_MSG              *NextPtr;                           /* Pointer to next message                                */
+    void                *MsgPtr;                            /* Actual message                                         */
+    OS_MSG_SIZE          MsgSize;                           /* Size of the message (in # bytes)                       */
+    CPU_TS               MsgTS;                             /* Time stamp of when message was sent                    */
+};
+
+struct  os_msg_pool                                         /* OS_MSG POOL                                            */
+{
+    OS_MSG              *NextPtr;                           /* Pointer to next message                                */
+    OS_MSG_QTY           NbrFree;                           /* Number of messages available from this pool            */
+    OS_MSG_QTY           NbrUsed;                           /* Current number of messages used                        */
+    OS_MSG_QTY           NbrUsedMax;                        /* Peak number of messages used                           */
+};
+
+struct  os_msg_q                                            /* OS_MSG_Q                                               */
+{
+    OS_MSG              *InPtr;                             /* Pointer to next OS_MSG to be inserted  in   the queue  */
+    OS_MSG              *OutPtr;                            /* Pointer to next OS_MSG to be extracted from the queue  */
+    OS_MSG_POOL         *PoolPtr;                           /* Pool the OS_MSGs of this queue are taken from          */
+    OS_MSG_QTY           NbrEntriesSize;                    /* Maximum allowable number of entries in the queue       */
+    OS_MSG_QTY           NbrEntries;                        /* Current number of entries in the queue                 */
+    OS_MSG_QTY           NbrEntriesMax;                     /* Peak number of entries in the queue                    */
+};
+
 /*
 ------------------------------------------------------------------------------------------------------------------------
 *                                                    MESSAGE QUEUES
 *
 * Note(s) : RTTϢuCOSϢʵֻȫͬ
-*           RTTϢǲݿķʽֱݵĴ
+*           RTTϢǲݿķʽֱݵĴ,ÿϢһϢͷ
 *           uCOSϢвôָ㿽ʽ
-*           ȻRTTҲôָķʽûṩurgentLIFOϢ,˲RTTϢʵ
-*           uCOSݵָݴСΪRTTϢеݶηװRTTϢ,Ҫucos_msg_tṹ
-*           ¹os_qṹ
+*           ˼ݲ㲻ٽRTTϢ,ʵ:ϢȫϢOSMsgPoolȡ,ʽڶ,
+*           ȴڰȼеĵȴб.Ͷʱڵȴֱӽȼߵ,ռϢ
+*           ں˶עΪRT_Object_Class_MessageQueue,ԱRTTĶͼ
+*           RTTԭϢҲעΪ,˼ݲҪOS_QʱֻOSQList,RTTĶ
+------------------------------------------------------------------------------------------------------------------------
+*/
+struct os_q
+{
+    struct  rt_ipc_object Parent;/*ں˶,suspend_threadΪ,ȴPendList*/
+    OS_PEND_LIST    PendList;/*ȴϢеб*/
+    rt_list_t       ListNode;/*OSQList*/
+    OS_MSG_Q        MsgQ;/*ϢеϢ*/
+#if OS_CFG_Q_STATIC_EN > 0u
+    OS_MSG_POOL     MsgPool;/*˽Ϣ,OSQCreateStatic()Ϣʹ*/
+#endif
+#if OS_CFG_Q_SPSC_EN > 0u
+    OS_MSG         *RingTbl;/*/߻λ,ΪNULLʾͨϢ*/
+    volatile OS_MSG_QTY   RingInIx;/*дλ,ȡֵΧ[0,2*NbrEntriesSize),޸*/
+    volatile OS_MSG_QTY   RingOutIx;/*λ,ȡֵΧ[0,2*NbrEntriesSize),޸*/
+    struct rt_thread * volatile RingWaitPtr;/*ȴ,ûΪNULL*/
+#endif
+    OS_CTR          PostCtr;/*ͶݳɹϢ*/
+    OS_CTR          PostFailCtr;/*ϢΪնͶʧܵĴ*/
+    OS_CTR          PendCtr;/*ȡߵϢ*/
+};
+
+/*
+------------------------------------------------------------------------------------------------------------------------
+*                                          SEMAPHORES / MUTEXES / EVENT FLAGS
+*
+* Note(s) : ź¼־ֱʹRTTں˶,ݲ󸽼uCOS-IIIҪĳԱ
+*           TSΪһͶ(Ϊһͷ)ʱ,OS_TS_GET()õ,ȴɹʱͨp_ts
 ------------------------------------------------------------------------------------------------------------------------
 */
-typedef  struct 
+struct os_sem
 {
-    rt_uint8_t *data_ptr;/*uCOS-IIIϢָ*/
-    rt_uint32_t data_size;/*uCOS-IIIϢݳ*/
-}ucos_msg_t;/*uCOSϢ*/
+    struct  rt_semaphore  Sem;/*RTTź,ΪһԱ*/
+    CPU_TS          TS;/*һͶݵʱ*/
+};
 
-struct os_q
+struct os_mutex
+{
+    struct  rt_mutex      Mutex;/*RTT,ΪһԱ*/
+    CPU_TS          TS;/*һͷŵʱ*/
+};
+
+struct os_flag_grp
 {
-    struct  rt_messagequeue rt_msg;
-    void    *p_pool;
-    ucos_msg_t ucos_msg;
+    struct  rt_event      Grp;/*RTT¼,ΪһԱ*/
+    CPU_TS          TS;/*һͶݵʱ*/
 };
 
 
+/*
+------------------------------------------------------------------------------------------------------------------------
+*                                                  TASK CONTROL BLOCK
+*
+* Note(s) : OS_TCBĵһԱΪRTT߳̿ƿ,OS_TCBֱָתΪrt_thread_tʹ;
+*           ֮,ֻͨOSTaskCreate(),rt_thread_self()תΪOS_TCBָ.
+*           ڽ(ڽϢ)ĵȴֻOSTaskCreate()
+*           OSTaskCreate()̵߳user_dataָ߳Ϊ,RTT߳ʱɾݴOS_TCB_GET()
+------------------------------------------------------------------------------------------------------------------------
+*/
+struct os_tcb
+{
+    struct rt_thread Task;/*RTT߳̿ƿ,ΪһԱ*/
+    OS_STATE         PendOn;/*ڵȴڽ,OS_TASK_PEND_ON_xxx*/
+    OS_STATUS        PendStatus;/*ȴ*/
+    void            *PendObjPtr;/*ڵȴźOS_Q(struct rt_object),ڵȴʱΪNULL*/
+    OS_PEND_DATA    *PendDataPtr;/*ȴͨOS_QʱPendListϵOS_PEND_DATA,ΪNULL*/
+    CPU_TS           TS;/*ڽźһͶݵʱ,ֱӽϢʱ*/
+#if OS_CFG_TASK_Q_EN > 0u
+    void            *MsgPtr;/*ȴڼֱӽϢ*/
+    OS_MSG_SIZE      MsgSize;
+    OS_MSG_Q         MsgQ;/*ڽϢ,ϢȡȫϢ*/
+#endif
+    OS_SEM_CTR       SemCtr;/*ڽźļֵ*/
+    OS_TICK          TimeQuanta;/*ʱƬ,Ϊ0ʱʹĬϳ*/
+    OS_TICK          TickCtrPrev;/*OS_OPT_TIME_PERIODICʱĻ׼ʱ,һڵĻʱ*/
+    OS_STATE         TaskState;/*ʱ/״̬,OS_TASK_STATE_xxx*/
+    void            *ExtPtr;/*OSTaskCreate()p_ext,ûTCBչ*/
+    void           (*TaskEntryAddr)(void *p_arg);/*(OS_TASK_PTR),OS_TaskEntry()*/
+    void            *TaskEntryArg;/*Ĳ*/
+#if OS_CFG_TASK_REG_TBL_SIZE > 0u
+    OS_REG           RegTbl[OS_CFG_TASK_REG_TBL_SIZE];/*Ĵ*/
+#endif
+#if OS_CFG_TLS_TBL_SIZE > 0u
+    OS_TLS          *TLS_Tbl;/*TLS۱,λջײ;OS_OPT_TASK_NO_TLSΪNULL*/
+#endif
+    CPU_INT08U      *StkMarkPtr;/*֪Ķջʹλ,·ĶջԱRTTʼʱ'#'*/
+#if OS_CFG_TASK_PROFILE_EN > 0u
+    OS_CTR           CtxSwCtr;/*леĴ*/
+    CPU_TS_TMR       CyclesStart;/*һαлʱʱ*/
+    OS_CYCLES        CyclesTotal;/*ۼеCPU*/
+    OS_CYCLES        CyclesTotalPrev;/*ͳһͳʱCyclesTotal*/
+    OS_CYCLES        CyclesDelta;/*һͳеCPU*/
+    OS_CPU_USAGE     CPUUsage;/*һͳڵCPUʹ,0~10000Ӧ0.00%~100.00%*/
+    OS_CPU_USAGE     CPUUsageMax;/*CPUUsageķֵ*/
+#endif
+#if OS_CFG_TASK_STK_LIMIT_EN > 0u
+    CPU_STK         *StkLimitPtr;/*ջλ,лʱSPڸλOS_AppStkLimitHookPtr*/
+#endif
+};
+
+#define  OS_TCB_GET(thread)     (((thread)->user_data == (rt_uint32_t)(thread)) ? (OS_TCB *)(thread) : (OS_TCB *)0)
+
+#if OS_CFG_TLS_TBL_SIZE > 0u                                /* TLS۱ռõĶջС(CPU_STKΪλ)               */
+#define  OS_TLS_STK_SIZE        ((OS_CFG_TLS_TBL_SIZE * sizeof(OS_TLS) + sizeof(CPU_STK) - 1u) / sizeof(CPU_STK))
+#endif
+
+#define  OSTCBCurPtr            ((OS_TCB *)rt_thread_self())/*ǰ,ֻOSTaskCreate()ܷչԱ*/
+
+/*
+------------------------------------------------------------------------------------------------------------------------
+*                                                  STACK USAGE REPORT
+*
+* Note(s) : OSTaskStkChkAll()Ϊÿ(߳)дһ,λOSTaskStkChk()ͬ
+------------------------------------------------------------------------------------------------------------------------
+*/
+typedef  struct  os_stk_info         OS_STK_INFO;
+
+struct os_stk_info
+{
+    struct rt_thread  *TaskPtr;/*(߳)ƿ,OSTaskCreate()ͨOS_TCB_GET()תΪOS_TCB*/
+    CPU_STK_SIZE       Free;/*ǰʣ*/
+    CPU_STK_SIZE       Used;/*ǰʹ*/
+    CPU_STK_SIZE       UsedMax;/*ʷʹ*/
+};
+
+
+/*
+------------------------------------------------------------------------------------------------------------------------
+*                                                 ISR POST DEFERRAL
+*
+* Note(s) : OS_CFG_ISR_POST_DEFERRED_ENΪ1ʱ,жеͶдö,ж϶дͶ
+*           TypeΪĿں˶RTT(RT_Object_Class_Semaphore);ڽûжӦRTT,
+*           ʹOS_OBJ_TYPE_TASK_xxx
+------------------------------------------------------------------------------------------------------------------------
+*/
+#if OS_CFG_ISR_POST_DEFERRED_EN > 0u
+#define  OS_OBJ_TYPE_TASK_MSG     (OS_OBJ_TYPE)(0x0100u | RT_Object_Class_Thread)   /* ڽϢ                 */
+#define  OS_OBJ_TYPE_TASK_SIGNAL  (OS_OBJ_TYPE)(0x0200u | RT_Object_Class_Thread)   /* ڽź                   */
+
+typedef  struct  os_int_q            OS_INT_Q;
+
+struct  os_int_q
+{
+    OS_OBJ_TYPE          Type;                              /* Type of object placed in the circular list             */
+    OS_INT_Q            *NextPtr;                           /* Pointer to next OS_INT_Q in  circular list             */
+    void                *ObjPtr;                            /* Pointer to object placed in the queue                  */
+    void                *MsgPtr;                            /* Pointer to message if posting to a message queue       */
+    OS_MSG_SIZE          MsgSize;                           /* Message Size       if posting to a message queue       */
+    OS_FLAGS             Flags;                             /* Value of flags if posting to an event flag group       */
+    OS_OPT               Opt;                               /* Post Options                                           */
+};
+#endif
+
+
 /*
 ************************************************************************************************************************
 ************************************************************************************************************************
@@ -461,13 +725,13 @@ struct os_q
 ************************************************************************************************************************
 ************************************************************************************************************************
 */
-typedef  struct  rt_event            OS_FLAG_GRP;
+typedef  struct  os_flag_grp         OS_FLAG_GRP;
 
 typedef  struct  os_q                OS_Q;
 
-typedef  struct  rt_mutex            OS_MUTEX;
+typedef  struct  os_mutex            OS_MUTEX;
 
-typedef  struct  rt_semaphore        OS_SEM;
+typedef  struct  os_sem              OS_SEM;
 
 /*ע⣺RTTĶʱصuCOS-IIIһ*/
 //typedef  void                      (*OS_TMR_CALLBACK_PTR)(void *p_tmr, void *p_arg);
@@ -475,7 +739,13 @@ typedef  void                        (*OS_TMR_CALLBACK_PTR)(void *parameter);
 typedef  struct  rt_timer            OS_TMR;
 
 typedef  void                        (*OS_TASK_PTR)        (void *parameter);
-typedef  struct  rt_thread           OS_TCB;
+typedef  struct  os_tcb              OS_TCB;
+
+typedef  void                        (*OS_APP_HOOK_TCB)    (OS_TCB *p_tcb);
+
+typedef  void                        (*OS_TLS_DESTRUCT_PTR)(OS_TCB    *p_tcb,
+                                                            OS_TLS_ID  id,
+                                                            OS_TLS     value);
 
 
 /*
@@ -551,9 +821,64 @@ void          OSTaskCreate              (OS_TCB                *p_tcb,
 void          OSTaskDel                 (OS_TCB                *p_tcb,
                                          OS_ERR                *p_err);
 
+#if OS_CFG_TASK_Q_EN > 0u
+OS_MSG_QTY    OSTaskQFlush              (OS_TCB                *p_tcb,
+                                         OS_ERR                *p_err);
+
+void         *OSTaskQPend               (OS_TICK                timeout,
+                                         OS_OPT                 opt,
+                                         OS_MSG_SIZE           *p_msg_size,
+                                         CPU_TS                *p_ts,
+                                         OS_ERR                *p_err);
+
+#if OS_CFG_TASK_Q_PEND_ABORT_EN > 0u
+CPU_BOOLEAN   OSTaskQPendAbort          (OS_TCB                *p_tcb,
+                                         OS_OPT                 opt,
+                                         OS_ERR                *p_err);
+#endif
+
+void          OSTaskQPost               (OS_TCB                *p_tcb,
+                                         void                  *p_void,
+                                         OS_MSG_SIZE            msg_size,
+                                         OS_OPT                 opt,
+                                         OS_ERR                *p_err);
+#endif
+
+#if OS_CFG_TASK_REG_TBL_SIZE > 0u
+OS_REG        OSTaskRegGet              (OS_TCB                *p_tcb,
+                                         OS_REG_ID              id,
+                                         OS_ERR                *p_err);
+
+OS_REG_ID     OSTaskRegGetID            (OS_ERR                *p_err);
+
+void          OSTaskRegSet              (OS_TCB                *p_tcb,
+                                         OS_REG_ID              id,
+                                         OS_REG                 value,
+                                         OS_ERR                *p_err);
+#endif
+
 void          OSTaskResume              (OS_TCB                *p_tcb,
                                          OS_ERR                *p_err);
 
+OS_SEM_CTR    OSTaskSemPend             (OS_TICK                timeout,
+                                         OS_OPT                 opt,
+                                         CPU_TS                *p_ts,
+                                         OS_ERR                *p_err);
+
+#if OS_CFG_TASK_SEM_PEND_ABORT_EN > 0u
+CPU_BOOLEAN   OSTaskSemPendAbort        (OS_TCB                *p_tcb,
+                                         OS_OPT                 opt,
+                                         OS_ERR                *p_err);
+#endif
+
+OS_SEM_CTR    OSTaskSemPost             (OS_TCB                *p_tcb,
+                                         OS_OPT                 opt,
+                                         OS_ERR                *p_err);
+
+OS_SEM_CTR    OSTaskSemSet              (OS_TCB                *p_tcb,
+                                         OS_SEM_CTR             cnt,
+                                         OS_ERR                *p_err);
+
 void          OSTaskSuspend             (OS_TCB                *p_tcb,
                                          OS_ERR                *p_err);
 
@@ -563,6 +888,10 @@ void          OSTaskStkChk              (OS_TCB                *p_tcb,
                                          CPU_STK_SIZE          *p_used_max,
                                          OS_ERR                *p_err);
 
+OS_OBJ_QTY    OSTaskStkChkAll           (OS_STK_INFO           *p_info_tbl,
+                                         OS_OBJ_QTY             nbr_max,
+                                         OS_ERR                *p_err);
+
 void          OSTaskTimeQuantaSet       (OS_TCB                *p_tcb,
                                          OS_TICK                time_quanta,
                                          OS_ERR                *p_err);
@@ -606,6 +935,22 @@ void          OSQCreate                 (OS_Q                  *p_q,
                                          OS_MSG_QTY             max_qty,
                                          OS_ERR                *p_err);
 
+#if OS_CFG_Q_SPSC_EN > 0u
+void          OSQCreateSPSC             (OS_Q                  *p_q,
+                                         CPU_CHAR              *p_name,
+                                         OS_MSG                *p_msg_tbl,
+                                         OS_MSG_QTY             max_qty,
+                                         OS_ERR                *p_err);
+#endif
+
+#if OS_CFG_Q_STATIC_EN > 0u
+void          OSQCreateStatic           (OS_Q                  *p_q,
+                                         CPU_CHAR              *p_name,
+                                         OS_MSG                *p_msg_tbl,
+                                         OS_MSG_QTY             max_qty,
+                                         OS_ERR                *p_err);
+#endif
+
 OS_OBJ_QTY    OSQDel                    (OS_Q                  *p_q,
                                          OS_OPT                 opt,
                                          OS_ERR                *p_err);
@@ -622,6 +967,17 @@ void         *OSQPend                   (OS_Q                  *p_q,
                                          CPU_TS                *p_ts,
                                          OS_ERR                *p_err);
 
+#if OS_CFG_Q_MULTI_EN > 0u
+OS_MSG_QTY    OSQPendMulti              (OS_Q                  *p_q,
+                                         OS_TICK                timeout,
+                                         OS_OPT                 opt,
+                                         void                 **p_void_tbl,
+                                         OS_MSG_SIZE           *p_size_tbl,
+                                         OS_MSG_QTY             nbr_max,
+                                         CPU_TS                *p_ts,
+                                         OS_ERR                *p_err);
+#endif
+
 #if OS_CFG_Q_PEND_ABORT_EN > 0u
 OS_OBJ_QTY    OSQPendAbort              (OS_Q                  *p_q,
                                          OS_OPT                 opt,
@@ -633,6 +989,18 @@ void          OSQPost                   (OS_Q                  *p_q,
                                          OS_MSG_SIZE            msg_size,
                                          OS_OPT                 opt,
                                          OS_ERR                *p_err);
+
+#if OS_CFG_Q_MULTI_EN > 0u
+OS_MSG_QTY    OSQPostMulti              (OS_Q                  *p_q,
+                                         void                 **p_void_tbl,
+                                         OS_MSG_SIZE           *p_size_tbl,
+                                         OS_MSG_QTY             nbr,
+                                         OS_OPT                 opt,
+                                         OS_ERR                *p_err);
+#endif
+
+void          OSQStatReset              (OS_Q                  *p_q,
+                                         OS_ERR                *p_err);
                                          
                             
 /* ================================================================================================================== */
@@ -689,10 +1057,14 @@ void          OSSchedUnlock             (OS_ERR                *p_err);
 
 void          OSStart                   (OS_ERR                *p_err);
 
+#if OS_CFG_STAT_TASK_EN > 0u
 void          OSStatReset               (OS_ERR                *p_err);
 
 void          OSStatTaskCPUUsageInit    (OS_ERR                *p_err);
 
+void          OS_StatTaskInit           (OS_ERR                *p_err);
+#endif
+
 CPU_INT16U    OSVersion                 (OS_ERR                *p_err);
 
 
@@ -753,4 +1125,161 @@ CPU_BOOLEAN   OSTmrStop                 (OS_TMR                *p_tmr,
                                          OS_ERR                *p_err);
 
 
+/* ================================================================================================================== */
+/*                                                 TASK LOCAL STORAGE                                                 */
+/* ================================================================================================================== */
+
+#if OS_CFG_TLS_TBL_SIZE > 0u
+OS_TLS_ID     OS_TLS_GetID              (OS_ERR                *p_err);
+
+OS_TLS        OS_TLS_GetValue           (OS_TCB                *p_tcb,
+                                         OS_TLS_ID              id,
+                                         OS_ERR                *p_err);
+
+void          OS_TLS_SetDestruct        (OS_TLS_ID              id,
+                                         OS_TLS_DESTRUCT_PTR    p_destruct,
+                                         OS_ERR                *p_err);
+
+void          OS_TLS_SetValue           (OS_TCB                *p_tcb,
+                                         OS_TLS_ID              id,
+                                         OS_TLS                 value,
+                                         OS_ERR                *p_err);
+#endif
+
+
+/*
+************************************************************************************************************************
+************************************************************************************************************************
+*                                           G L O B A L   V A R I A B L E S
+************************************************************************************************************************
+************************************************************************************************************************
+*/
+
+extern  OS_MSG_POOL   OSMsgPool;                            /* Pool of OS_MSG                                         */
+extern  rt_list_t     OSQList;                              /* List of all the OS_Qs (RTTԭϢ)          */
+
+#if OS_CFG_TASK_STK_LIMIT_EN > 0u
+extern  OS_APP_HOOK_TCB  OS_AppStkLimitHookPtr;             /* Called when a task has used its stack beyond stk_limit */
+#endif
+
+#if OS_CFG_STAT_TASK_EN > 0u
+extern  OS_CPU_USAGE  OSStatTaskCPUUsage;                   /* CPU Usage in % (0~10000)                               */
+extern  OS_CPU_USAGE  OSStatTaskCPUUsageMax;                /* CPU Usage in % (Peak)                                  */
+extern  OS_TICK       OSStatTaskCtr;                        /* Idle counter, incremented by the idle task hook        */
+extern  OS_TICK       OSStatTaskCtrMax;                     /* Idle counter value during one period with no load      */
+extern  OS_TICK       OSStatTaskCtrRun;                     /* Idle counter value of the last period                  */
+extern  CPU_BOOLEAN   OSStatTaskRdy;                        /* Flag indicating that the statistic task is ready       */
+#endif
+
+#if OS_CFG_TASK_REG_TBL_SIZE > 0u
+extern  OS_REG_ID     OSTaskRegNextAvailID;                 /* Next available Task Register ID                        */
+#endif
+
+extern  CPU_BOOLEAN   OSSchedRoundRobinEn;                  /* Enable/Disable round-robin scheduling                  */
+extern  OS_TICK       OSSchedRoundRobinDfltTimeQuanta;      /* Default time quanta (ticks) of a task                  */
+
+#if OS_CFG_ISR_POST_DEFERRED_EN > 0u
+extern  OS_INT_Q     *OSIntQInPtr;                          /* Pointer to the next entry to insert                    */
+extern  OS_INT_Q     *OSIntQOutPtr;                         /* Pointer to the next entry to extract                   */
+extern  OS_OBJ_QTY    OSIntQNbrEntries;                     /* Number of entries in the ISR queue                     */
+extern  OS_OBJ_QTY    OSIntQNbrEntriesMax;                  /* Peak number of entries in the ISR queue                */
+extern  OS_OBJ_QTY    OSIntQOvfCtr;                         /* Number of posts lost because the ISR queue was full    */
+#endif
+
+
+/*
+************************************************************************************************************************
+************************************************************************************************************************
+*                                  ݲڲԭ(ӦóӦֱӵ)
+************************************************************************************************************************
+************************************************************************************************************************
+*/
+
+void          OS_PendListInit           (OS_PEND_LIST          *p_pend_list);
+
+void          OS_PendListInsertPrio     (OS_PEND_LIST          *p_pend_list,
+                                         OS_PEND_DATA          *p_pend_data);
+
+void          OS_PendListRemove         (OS_PEND_LIST          *p_pend_list,
+                                         OS_PEND_DATA          *p_pend_data);
+
+void          OS_Pend                   (void                  *p_obj,
+                                         OS_PEND_LIST          *p_pend_list,
+                                         OS_PEND_DATA          *p_pend_data,
+                                         rt_int32_t             time,
+                                         CPU_SR                 cpu_sr);
+
+OS_OBJ_QTY    OS_Post                   (OS_PEND_LIST          *p_pend_list,
+                                         void                  *p_void,
+                                         OS_MSG_SIZE            msg_size,
+                                         OS_STATUS              status,
+                                         CPU_TS                 ts,
+                                         CPU_BOOLEAN            all);
+
+rt_ubase_t    OS_SchedRoundRobinQuanta  (OS_TICK                time_quanta);
+
+#ifdef RT_USING_HOOK
+void          OS_TaskSwHook             (rt_thread_t            from,
+                                         rt_thread_t            to);
+#endif
+
+void          OS_TaskChangePrio         (rt_thread_t            thread,
+                                         OS_PRIO                prio_new);
+
+void          OS_TaskPendDel            (rt_thread_t            thread);
+
+void          OS_TaskBlock              (OS_TCB                *p_tcb,
+                                         OS_STATE               pend_on,
+                                         rt_int32_t             time,
+                                         CPU_SR                 cpu_sr);
+
+CPU_BOOLEAN   OS_TaskRdy                (OS_TCB                *p_tcb,
+                                         OS_STATE               pend_on,
+                                         OS_STATUS              status);
+
+#if OS_CFG_ISR_POST_DEFERRED_EN > 0u
+void          OS_IntQPost               (OS_OBJ_TYPE            type,
+                                         void                  *p_obj,
+                                         void                  *p_void,
+                                         OS_MSG_SIZE            msg_size,
+                                         OS_FLAGS               flags,
+                                         OS_OPT                 opt,
+                                         OS_ERR                *p_err);
+
+void          OS_IntQTaskInit           (OS_ERR                *p_err);
+#endif
+
+#if OS_CFG_TLS_TBL_SIZE > 0u
+void          OS_TLS_TaskCreate         (OS_TCB                *p_tcb,
+                                         CPU_STK               *p_stk_base,
+                                         OS_OPT                 opt);
+
+void          OS_TLS_TaskDel            (OS_TCB                *p_tcb);
+#endif
+
+void          OS_MsgPoolCreate          (OS_MSG_POOL           *p_pool,
+                                         OS_MSG                *p_msg_tbl,
+                                         OS_MSG_QTY             qty);
+
+void          OS_MsgPoolInit            (OS_ERR                *p_err);
+
+OS_MSG_QTY    OS_MsgQFreeAll            (OS_MSG_Q              *p_msg_q);
+
+void          OS_MsgQInit               (OS_MSG_Q              *p_msg_q,
+                                         OS_MSG_POOL           *p_pool,
+                                         OS_MSG_QTY             size);
+
+void         *OS_MsgQGet                (OS_MSG_Q              *p_msg_q,
+                                         OS_MSG_SIZE           *p_msg_size,
+                                         CPU_TS                *p_ts,
+                                         OS_ERR                *p_err);
+
+void          OS_MsgQPut                (OS_MSG_Q              *p_msg_q,
+                                         void                  *p_void,
+                                         OS_MSG_SIZE            msg_size,
+                                         OS_OPT                 opt,
+                                         CPU_TS                 ts,
+                                         OS_ERR                *p_err);
+
+
 #endif
@@ -49,4 +49,44 @@
 
 #define  OS_CFG_TMR_TASK_RATE_HZ         100u               /* Rate for timers (100 Hz Typ.) */
 
+#define  OS_CFG_MSG_POOL_SIZE            32u                /* Number of OS_MSGs shared by all message queues (0 = no global pool) */
+
+#define  OS_CFG_Q_FLUSH_EN               1u                 /* Include code for OSQFlush() */
+
+#define  OS_CFG_Q_PEND_ABORT_EN          1u                 /* Include code for OSQPendAbort() */
+
+#define  OS_CFG_Q_MULTI_EN               1u                 /* Include code for OSQPostMulti() and OSQPendMulti() */
+
+#define  OS_CFG_Q_STATIC_EN              1u                 /* Enable (1) or Disable (0) OSQCreateStatic() (caller-supplied OS_MSG storage) */
+
+#define  OS_CFG_Q_SPSC_EN                1u                 /* Enable (1) or Disable (0) OSQCreateSPSC() (lock-free single producer/consumer queue) */
+
+#define  OS_CFG_TASK_Q_EN                1u                 /* Include code for OSTaskQxxx() */
+
+#define  OS_CFG_TASK_Q_PEND_ABORT_EN     1u                 /* Include code for OSTaskQPendAbort() */
+
+#define  OS_CFG_TASK_SEM_PEND_ABORT_EN   1u                 /* Include code for OSTaskSemPendAbort() */
+
+#define  OS_CFG_TASK_REG_TBL_SIZE        1u                 /* Number of task specific registers */
+
+#define  OS_CFG_TLS_TBL_SIZE             2u                 /* Number of Task Local Storage slots per task (0 = no TLS) */
+
+#define  OS_CFG_TASK_STK_LIMIT_EN        1u                 /* Check the stack of a task against its stk_limit on context switch (needs RT_USING_HOOK) */
+
+#define  OS_CFG_TASK_PROFILE_EN          1u                 /* Include variables in OS_TCB for profiling (needs RT_USING_HOOK) */
+
+#define  OS_CFG_STAT_TASK_EN             1u                 /* Enable (1) or Disable (0) the statistic task */
+
+#define  OS_CFG_STAT_TASK_PRIO           (RT_THREAD_PRIORITY_MAX-2) /* Priority of the statistic task (just above the idle thread) */
+
+#define  OS_CFG_STAT_TASK_RATE_HZ        10u                /* Rate of execution of the statistic task (1 to 10 Hz) */
+
+#define  OS_CFG_STAT_TASK_STK_SIZE       512u               /* Stack size (bytes) of the statistic task */
+
+#define  OS_CFG_ISR_POST_DEFERRED_EN     0u                 /* Enable (1) or Disable (0) Deferred ISR posts */
+
+#define  OS_CFG_INT_Q_SIZE               10u                /* Size of ISR handler task queue */
+
+#define  OS_CFG_INT_Q_TASK_STK_SIZE      512u               /* Stack size (bytes) of ISR handler task */
+
 #endif
@@ -44,12 +44,156 @@
 
 /*
 RTTӹ,ºʵ
-OSInit
 OSStart
-RTTûؽӿڣºûʵ
-OSSchedRoundRobinCfg
+OSInitʼݲԴ,RTTں˵ĳʼRTT
 */
 
+/*
+ʱƬת˵:
+    RTTʼնͬȼ߳̽ʱƬת,ʱƬΪ̵߳init_tick.ݲͨ޸init_tickʵuCOS-III:
+    ʹʱOSTaskCreate()TimeQuanta(Ϊ0ʱΪĬϳ)ΪʱƬ,ֹʱʱƬΪֵ,൱ڲת
+    OSSchedRoundRobinCfg()ֻOSTaskCreate(),RTTԭ̵߳ʱƬֲ
+*/
+
+/*
+лӵ˵:
+    ݲOSInit()ͨrt_scheduler_sethook()עOS_TaskSwHook(),RTTÿεлʱ,
+    Ҫrtconfig.hпRT_USING_HOOK;ӦóӦٵrt_scheduler_sethook(),ḲǸù
+*/
+
+#if OS_CFG_TASK_STK_LIMIT_EN > 0u
+#ifndef RT_USING_HOOK
+#error "OS_CFG_TASK_STK_LIMIT_ENҪrtconfig.hпRT_USING_HOOK"
+#endif
+OS_APP_HOOK_TCB  OS_AppStkLimitHookPtr = (OS_APP_HOOK_TCB)0;
+#endif
+
+#if (OS_CFG_TASK_PROFILE_EN > 0u) && !defined(RT_USING_HOOK)
+#error "OS_CFG_TASK_PROFILE_ENҪrtconfig.hпRT_USING_HOOK"
+#endif
+
+CPU_BOOLEAN   OSSchedRoundRobinEn             = DEF_TRUE;                       /* RTTĬϾͽʱƬת      */
+OS_TICK       OSSchedRoundRobinDfltTimeQuanta = RT_TICK_PER_SECOND / 10u;
+
+/*ڵCPU_TS_Update(),ֹCPU_TS_Get64()©DWTĻ;Ƶ400MHz»һȦ10*/
+#define  OS_TS_UPDATE_PERIOD           (RT_TICK_PER_SECOND * 10u)
+static  struct rt_timer  OS_TS_UpdateTmr;
+
+static  void  OS_TS_UpdateCallback (void  *p_arg)
+{
+    CPU_TS_Update();
+}
+
+/*
+************************************************************************************************************************
+*                                                    INITIALIZATION
+*
+* Description: This function is used to initialize the internals of uC/OS-III and MUST be called prior to creating any
+*              uC/OS-III object and, prior to calling OSStart().
+*
+* Arguments  : p_err         is a pointer to a variable that will contain an error code returned by this function.
+*
+*                                OS_ERR_NONE    Initialization was successful
+*                                Other          Other OS_ERR_xxx depending on the sub-functions called by OSInit().
+* Returns    : none
+*
+* Note(s)    : 1) RTTںڽmain֮ǰѾ˳ʼ,ʼݲԴ(Ϣءж϶д),
+*                 ӦmainСκuCOS-IIIں˶֮ǰ
+************************************************************************************************************************
+*/
+
+void  OSInit (OS_ERR  *p_err)
+{
+    OS_MsgPoolInit(p_err);                                  /* Initialize the free list of OS_MSGs                    */
+    if(*p_err != OS_ERR_NONE)
+    {
+        return;
+    }
+
+    CPU_TS_TmrInit();                                       /* Start the cycle counter used for timestamps/profiling  */
+    rt_timer_init(&OS_TS_UpdateTmr, "ts_upd", OS_TS_UpdateCallback, RT_NULL,
+                  OS_TS_UPDATE_PERIOD, RT_TIMER_FLAG_PERIODIC | RT_TIMER_FLAG_HARD_TIMER);
+    rt_timer_start(&OS_TS_UpdateTmr);
+
+#ifdef RT_USING_HOOK
+    rt_scheduler_sethook(OS_TaskSwHook);                    /* Hook called by RT-Thread on every context switch       */
+#endif
+
+#if OS_CFG_STAT_TASK_EN > 0u
+    OS_StatTaskInit(p_err);                                 /* Create the statistic task                              */
+    if(*p_err != OS_ERR_NONE)
+    {
+        return;
+    }
+#endif
+
+#if OS_CFG_ISR_POST_DEFERRED_EN > 0u
+    OS_IntQTaskInit(p_err);                                 /* Setup the ISR queue and create the ISR handler task    */
+    if(*p_err != OS_ERR_NONE)
+    {
+        return;
+    }
+#endif
+}
+
+/*
+************************************************************************************************************************
+*                                                 CONTEXT SWITCH HOOK
+*
+* Description: This function is called by RT-Thread every time it switches from one task to another.
+*
+* Arguments  : from      is a pointer to the task being switched out
+*
+*              to        is a pointer to the task being switched in
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) RTTڲжϵ״̬µ,뾡С,еõûҲܵûȵĺ
+*              3) ջ:'to'ϴαлȥʱSPʱջ,StkLimitPtrȽһμ.
+*                 SPھλʱÿл񶼻OS_AppStkLimitHookPtr
+*              4) ʱͳ:DWTڼгʱ,гʱѱеۼӵCyclesTotal,
+*                 ͳΪCPUUsage.ֻͳOSTaskCreate()
+************************************************************************************************************************
+*/
+
+#ifdef RT_USING_HOOK
+void  OS_TaskSwHook (rt_thread_t  from,
+                     rt_thread_t  to)
+{
+    OS_TCB      *p_tcb;
+#if OS_CFG_TASK_PROFILE_EN > 0u
+    CPU_TS_TMR   ts;
+
+
+    ts    = CPU_TS_TmrRd();
+    p_tcb = OS_TCB_GET(from);
+    if(p_tcb != RT_NULL)
+    {
+        p_tcb->CyclesTotal += (OS_CYCLES)(ts - p_tcb->CyclesStart);
+    }
+    p_tcb = OS_TCB_GET(to);
+    if(p_tcb != RT_NULL)
+    {
+        p_tcb->CyclesStart = ts;
+        p_tcb->CtxSwCtr++;
+    }
+#endif
+
+#if OS_CFG_TASK_STK_LIMIT_EN > 0u
+    p_tcb = OS_TCB_GET(to);
+    if(p_tcb != RT_NULL && (CPU_STK *)to->sp < p_tcb->StkLimitPtr)
+    {
+        if(OS_AppStkLimitHookPtr != (OS_APP_HOOK_TCB)0)
+        {
+            (*OS_AppStkLimitHookPtr)(p_tcb);
+        }
+    }
+#endif
+    (void)from;
+}
+#endif
+
 /*
 ************************************************************************************************************************
 *                                                      ENTER ISR
@@ -104,6 +248,10 @@ void  OSIntEnter (void)
 void  OSIntExit (void)
 {
     rt_interrupt_leave();
+    if(rt_interrupt_get_nest() == 0)/*ж˳ʱһ,ждOS_OPT_POST_NO_SCHEDͶڴл*/
+    {
+        rt_schedule();
+    }
 }
 
 /*
@@ -123,6 +271,7 @@ void  OSIntExit (void)
 */
 void  OSSched (void)
 {
+    /*OS_OPT_POST_NO_SCHEDͶֻ,ɱͳһһ*/
     rt_schedule();
 }
 
@@ -228,15 +377,62 @@ void  OSSchedUnlock (OS_ERR  *p_err)
 *              p_err             is a pointer to a variable that will contain an error code returned by this function.
 *
 *                                    OS_ERR_NONE    The call was successful
+*                                    OS_ERR_SET_ISR If uC/OS-III was called from an ISR
 *
 * Returns    : none
+*
+* Note(s)    : 1) µдinit_tick,ڽеʱƬµʱƬ򱻽ض,һʱƬЧ
 ************************************************************************************************************************
 */
 void  OSSchedRoundRobinCfg (CPU_BOOLEAN   en,
                             OS_TICK       dflt_time_quanta,
                             OS_ERR       *p_err)
 {
+    struct rt_object_information  *p_info;
+    rt_list_t                     *p_node;
+    rt_thread_t                    thread;
+    OS_TCB                        *p_tcb;
+    CPU_SR_ALLOC();
+    
+    /*Ƿж*/
+    if(rt_interrupt_get_nest()!=0)
+    {
+        *p_err = OS_ERR_SET_ISR;
+        return;
+    }
+    
+    CPU_CRITICAL_ENTER();
+    OSSchedRoundRobinEn = en;
+    if(dflt_time_quanta > 0)
+    {
+        OSSchedRoundRobinDfltTimeQuanta = dflt_time_quanta;
+    }
+    else
+    {
+        OSSchedRoundRobinDfltTimeQuanta = RT_TICK_PER_SECOND / 10u;
+    }
+    
+    /*OSTaskCreate()ʱƬ*/
+    p_info = rt_object_get_information(RT_Object_Class_Thread);
+    for(p_node  = p_info->object_list.next;
+        p_node != &p_info->object_list;
+        p_node  = p_node->next)
+    {
+        thread = (rt_thread_t)rt_list_entry(p_node, struct rt_object, list);
+        p_tcb  = OS_TCB_GET(thread);
+        if(p_tcb == RT_NULL)
+        {
+            continue;
+        }
+        thread->init_tick = OS_SchedRoundRobinQuanta(p_tcb->TimeQuanta);
+        if(thread->remaining_tick > thread->init_tick)
+        {
+            thread->remaining_tick = thread->init_tick;
+        }
+    }
+    CPU_CRITICAL_EXIT();
     
+    *p_err = OS_ERR_NONE;
 }
 
 /*
@@ -249,7 +445,7 @@ void  OSSchedRoundRobinCfg (CPU_BOOLEAN   en,
 *
 *                             OS_ERR_NONE                   The call was successful
 *                           - OS_ERR_ROUND_ROBIN_1          Only 1 task at this priority, nothing to yield to
-*                           - OS_ERR_ROUND_ROBIN_DISABLED   Round Robin is not enabled
+*                             OS_ERR_ROUND_ROBIN_DISABLED   Round Robin is not enabled
 *                             OS_ERR_SCHED_LOCKED           The scheduler has been locked
 *                             OS_ERR_YIELD_ISR              Can't be called from an ISR
 *                         -------------˵-------------
@@ -281,6 +477,12 @@ void  OSSchedRoundRobinYield (OS_ERR  *p_err)
         return;         
     }
     
+    if(OSSchedRoundRobinEn != DEF_TRUE)
+    {
+        *p_err = OS_ERR_ROUND_ROBIN_DISABLED;
+        return;
+    }
+    
     rt_err = rt_thread_yield();
     *p_err = _err_rtt_to_ucosiii(rt_err); 
 }
@@ -305,3 +507,542 @@ CPU_INT16U  OSVersion (OS_ERR  *p_err)
     *p_err = OS_ERR_NONE;
     return RTTHREAD_VERSION;
 }
+
+/*
+************************************************************************************************************************
+*                                               INITIALIZE A WAIT LIST
+*
+* Description: This function is called to initialize the fields of an OS_PEND_LIST.
+*
+* Arguments  : p_pend_list   is a pointer to an OS_PEND_LIST
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+************************************************************************************************************************
+*/
+
+void  OS_PendListInit (OS_PEND_LIST  *p_pend_list)
+{
+    rt_list_init(&p_pend_list->List);
+    p_pend_list->NbrEntries = (OS_OBJ_QTY)0;
+}
+
+/*
+************************************************************************************************************************
+*                                INSERT A PEND DATA ENTRY BASED ON IT'S PRIORITY IN A LIST
+*
+* Description: This function is called to place an OS_PEND_DATA entry in a linked list based on its priority.  The
+*              highest priority being placed at the head of the list.  Tasks of the same priority are placed in FIFO
+*              order.
+*
+* Arguments  : p_pend_list   is a pointer to the wait list
+*
+*              p_pend_data   is a pointer to the OS_PEND_DATA to insert (its TCBPtr must already be set)
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) ڹжϵ״̬µ
+************************************************************************************************************************
+*/
+
+void  OS_PendListInsertPrio (OS_PEND_LIST  *p_pend_list,
+                             OS_PEND_DATA  *p_pend_data)
+{
+    rt_list_t     *p_node;
+    OS_PEND_DATA  *p_pend_data_cur;
+
+
+    for(p_node  = p_pend_list->List.next;
+        p_node != &p_pend_list->List;
+        p_node  = p_node->next)
+    {
+        p_pend_data_cur = rt_list_entry(p_node, OS_PEND_DATA, List);
+        if(p_pend_data->TCBPtr->current_priority < p_pend_data_cur->TCBPtr->current_priority)
+        {
+            break;/*RTTȼֵԽС,ȼԽ*/
+        }
+    }
+    rt_list_insert_before(p_node, &p_pend_data->List);
+    p_pend_list->NbrEntries++;
+}
+
+/*
+************************************************************************************************************************
+*                                         REMOVE A PEND DATA ENTRY FROM A LIST
+*
+* Description: This function is called to remove an OS_PEND_DATA entry from a wait list.
+*
+* Arguments  : p_pend_list   is a pointer to the wait list
+*
+*              p_pend_data   is a pointer to the OS_PEND_DATA to remove
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) ڹжϵ״̬µ
+************************************************************************************************************************
+*/
+
+void  OS_PendListRemove (OS_PEND_LIST  *p_pend_list,
+                         OS_PEND_DATA  *p_pend_data)
+{
+    rt_list_remove(&p_pend_data->List);/*Ƴڵָ,ȴݴжǷѱͶݷȡ*/
+    p_pend_list->NbrEntries--;
+}
+
+/*
+************************************************************************************************************************
+*                                     BLOCK THE CURRENT TASK ON A WAIT LIST
+*
+* Description: This function is called to place the current task in the wait list of a kernel object and to block it
+*              until the object is posted, the pend is aborted, the object is deleted or the timeout expires.
+*
+* Arguments  : p_obj         is a pointer to the kernel object (its struct rt_object) the task waits on
+*
+*              p_pend_list   is a pointer to the wait list of the kernel object
+*
+*              p_pend_data   is a pointer to an OS_PEND_DATA allocated on the stack of the pending task
+*
+*              time          RTTĳʱʱ:RT_WAITING_FOREVERʾõȴ,0ʾȴtick
+*
+*              cpu_sr        ÷ͨCPU_CRITICAL_ENTER()жʱCPU״̬
+*
+* Returns    : none. ȴp_pend_data->PendStatus,ΪOS_STATUS_PEND_OK,Ϣp_pend_data->MsgPtr
+*              p_pend_data->MsgSize.p_pend_data->TSΪͶݷʱ,ʱΪ0
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) ڹжϵ״̬µ,ڲῪжϲ,ʱж״̬ѻָΪcpu_sr
+*              3) RTT߳ԴĶʱʵֳʱ,ʱRTTὫ̵߳errorΪ-RT_ETIMEOUT߳.
+*                 ָк,OS_PEND_DATAԹڵȴб,˵ûбͶݷȡ(ʱʽ)
+*              4) OSTaskCreate()ڵȴڼ佫p_objp_pend_data¼OS_TCB,OS_TaskChangePrio()
+************************************************************************************************************************
+*/
+
+void  OS_Pend (void          *p_obj,
+               OS_PEND_LIST  *p_pend_list,
+               OS_PEND_DATA  *p_pend_data,
+               rt_int32_t     time,
+               CPU_SR         cpu_sr)
+{
+    rt_thread_t  thread;
+    OS_TCB      *p_tcb;
+
+
+    thread = rt_thread_self();
+    p_tcb  = OS_TCB_GET(thread);
+    if(p_tcb != RT_NULL)
+    {
+        p_tcb->PendObjPtr  = p_obj;
+        p_tcb->PendDataPtr = p_pend_data;
+    }
+
+    p_pend_data->TCBPtr     = thread;
+    p_pend_data->MsgPtr     = RT_NULL;
+    p_pend_data->MsgSize    = (OS_MSG_SIZE)0;
+    p_pend_data->TS         = (CPU_TS)0;
+    p_pend_data->PendStatus = OS_STATUS_PEND_OK;
+    OS_PendListInsertPrio(p_pend_list, p_pend_data);
+
+    thread->error = RT_EOK;
+    rt_thread_suspend(thread);
+    if(time > 0)/*̶߳ʱгʱʱ*/
+    {
+        rt_timer_control(&(thread->thread_timer), RT_TIMER_CTRL_SET_TIME, &time);
+        rt_timer_start(&(thread->thread_timer));
+    }
+    CPU_CRITICAL_EXIT();
+
+    rt_schedule();
+
+    CPU_CRITICAL_ENTER();
+    if(p_tcb != RT_NULL)
+    {
+        p_tcb->PendObjPtr  = RT_NULL;
+        p_tcb->PendDataPtr = RT_NULL;
+    }
+    if(p_pend_data->List.next != &p_pend_data->List)/*ڵȴб,˵ǱͶݷѵ*/
+    {
+        OS_PendListRemove(p_pend_list, p_pend_data);
+        if(thread->error == -RT_ETIMEOUT)
+        {
+            p_pend_data->PendStatus = OS_STATUS_PEND_TIMEOUT;
+        }
+        else
+        {
+            p_pend_data->PendStatus = OS_STATUS_PEND_ABORT;
+        }
+    }
+    CPU_CRITICAL_EXIT();
+}
+
+/*
+************************************************************************************************************************
+*                                           READY TASK(S) WAITING ON A WAIT LIST
+*
+* Description: This function is called to hand a message (or a pend status) directly to the highest priority task
+*              waiting on a wait list, or to all of them, and to make the task(s) ready to run.
+*
+* Arguments  : p_pend_list   is a pointer to the wait list of the kernel object
+*
+*              p_void        is a pointer to the message to hand to the waiting task(s)
+*
+*              msg_size      is the size of the message
+*
+*              status        is the pend status to hand to the waiting task(s):
+*
+*                                OS_STATUS_PEND_OK       the object was posted
+*                                OS_STATUS_PEND_ABORT    the pend was aborted
+*                                OS_STATUS_PEND_DEL      the object was deleted
+*
+*              ts            is the timestamp of the post, abort or delete, handed to the waiting task(s)
+*
+*              all           DEF_TRUEʾȫȴ,DEF_FALSEʾȼߵĵȴ
+*
+* Returns    : The number of tasks made ready to run
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) ڹжϵ״̬µ,ᴥ,ɵ÷ڿжϺеOSSched()
+************************************************************************************************************************
+*/
+
+OS_OBJ_QTY  OS_Post (OS_PEND_LIST  *p_pend_list,
+                     void          *p_void,
+                     OS_MSG_SIZE    msg_size,
+                     OS_STATUS      status,
+                     CPU_TS         ts,
+                     CPU_BOOLEAN    all)
+{
+    OS_PEND_DATA  *p_pend_data;
+    OS_OBJ_QTY     nbr_tasks;
+
+
+    nbr_tasks = (OS_OBJ_QTY)0;
+    while(!rt_list_isempty(&p_pend_list->List))
+    {
+        p_pend_data = rt_list_entry(p_pend_list->List.next, OS_PEND_DATA, List);
+        OS_PendListRemove(p_pend_list, p_pend_data);
+        p_pend_data->MsgPtr     = p_void;
+        p_pend_data->MsgSize    = msg_size;
+        p_pend_data->TS         = ts;
+        p_pend_data->PendStatus = status;
+        rt_thread_resume(p_pend_data->TCBPtr);/*ѳʱ,᷵ش,ԻȡϢ*/
+        nbr_tasks++;
+
+        if(all != DEF_TRUE)
+        {
+            break;
+        }
+    }
+    return nbr_tasks;
+}
+
+/*
+************************************************************************************************************************
+*                                           GET THE TIME SLICE OF A TASK
+*
+* Description: This function is called to compute the time slice that RT-Thread must use for a task created by
+*              OSTaskCreate(), based on its own time quanta and on the round-robin configuration.
+*
+* Arguments  : time_quanta   is the time quanta of the task (0 means the default time quanta)
+*
+* Returns    : The time slice in ticks, to be written into the init_tick of the thread
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) ʱƬתֹʱֵ,RTTڸʱƬľ֮ǰת
+************************************************************************************************************************
+*/
+
+rt_ubase_t  OS_SchedRoundRobinQuanta (OS_TICK  time_quanta)
+{
+    if(OSSchedRoundRobinEn != DEF_TRUE)
+    {
+        return (rt_ubase_t)~(rt_ubase_t)0;
+    }
+    if(time_quanta == 0)
+    {
+        return OSSchedRoundRobinDfltTimeQuanta;
+    }
+    return time_quanta;
+}
+
+/*
+************************************************************************************************************************
+*                                           CHANGE THE PRIORITY OF A TASK
+*
+* Description: This function is called to change the current priority of a task and to move it to the proper place
+*              in the ready list or in the wait list it is waiting on.  If the task waits on a mutex whose owner has a
+*              lower priority, the owner inherits the new priority.
+*
+* Arguments  : thread        is a pointer to the task whose priority is changed
+*
+*              prio_new      is the new current priority
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) ڹжϵ״̬µ,ᴥ
+*              3) бrt_thread_control();RTT¼߳ڵȴĸں˶,OSTaskCreate()
+*                 ڵȴźOS_Qڼ佫ö¼PendObjPtr,ֻöĵȴб,
+*                 жϵʱϵͳں˶޹.¼־鰴FIFO,Ҫ
+*              4) RTTԭ߳ûOS_TCB,RTTȼ̳һֻȼ,ڵĵȴб
+************************************************************************************************************************
+*/
+
+void  OS_TaskChangePrio (rt_thread_t  thread,
+                         OS_PRIO      prio_new)
+{
+    struct rt_ipc_object  *p_ipc;
+    rt_list_t             *p_node;
+    rt_thread_t            thread_cur;
+    rt_mutex_t             p_mutex;
+    OS_TCB                *p_tcb;
+    OS_Q                  *p_q;
+    OS_PEND_DATA          *p_pend_data;
+    rt_uint8_t             prio;
+
+
+    prio = prio_new;
+    rt_thread_control(thread, RT_THREAD_CTRL_CHANGE_PRIORITY, &prio);/*̴߳ھ̬,ͬʱھбеλ*/
+
+    if((thread->stat & RT_THREAD_STAT_MASK) != RT_THREAD_SUSPEND)
+    {
+        return;
+    }
+    p_tcb = OS_TCB_GET(thread);
+    if(p_tcb == RT_NULL || p_tcb->PendObjPtr == RT_NULL)/*RTTԭ߳,ڵȴں˶*/
+    {
+        return;
+    }
+    p_ipc = (struct rt_ipc_object *)p_tcb->PendObjPtr;
+
+    /*ȴOS_Q:߳ͨOS_PEND_DATAϢеPendList,SPSCϢֻһȴ,Ҫ*/
+    if(rt_object_get_type(&p_ipc->parent) == RT_Object_Class_MessageQueue)
+    {
+        p_q         = (OS_Q *)p_ipc;
+        p_pend_data = p_tcb->PendDataPtr;
+        if(p_pend_data != RT_NULL && p_pend_data->List.next != &p_pend_data->List)
+        {
+            OS_PendListRemove(&p_q->PendList, p_pend_data);
+            OS_PendListInsertPrio(&p_q->PendList, p_pend_data);
+        }
+        return;
+    }
+
+    /*ȴRTTIPC:߳ͨtlistڶsuspend_thread*/
+    for(p_node  = p_ipc->suspend_thread.next;
+        p_node != &p_ipc->suspend_thread;
+        p_node  = p_node->next)
+    {
+        if(p_node == &thread->tlist)
+        {
+            break;
+        }
+    }
+    if(p_node == &p_ipc->suspend_thread)/*ѱͶݷ,δʱֱ*/
+    {
+        return;
+    }
+
+    if(p_ipc->parent.flag == RT_IPC_FLAG_PRIO)/*ȼ²*/
+    {
+        rt_list_remove(&thread->tlist);
+        for(p_node  = p_ipc->suspend_thread.next;
+            p_node != &p_ipc->suspend_thread;
+            p_node  = p_node->next)
+        {
+            thread_cur = rt_list_entry(p_node, struct rt_thread, tlist);
+            if(thread->current_priority < thread_cur->current_priority)
+            {
+                break;
+            }
+        }
+        rt_list_insert_before(p_node, &thread->tlist);
+    }
+
+    if(rt_object_get_type(&p_ipc->parent) == RT_Object_Class_Mutex)/*ȼ̳:ߵȼܵڵȴ*/
+    {
+        p_mutex = (rt_mutex_t)p_ipc;
+        if(p_mutex->owner != RT_NULL && prio_new < p_mutex->owner->current_priority)
+        {
+            OS_TaskChangePrio(p_mutex->owner, prio_new);
+        }
+    }
+}
+
+/*
+************************************************************************************************************************
+*                                      REMOVE A TASK BEING DELETED FROM THE WAIT LISTS
+*
+* Description: This function is called when a task is deleted to unlink it from the wait list of any OS_Q it is waiting
+*              on.  The OS_PEND_DATA of the task lives on its stack, so it must not stay linked after the task is gone.
+*
+* Arguments  : thread        is a pointer to the task being deleted
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) ڹжϵ״̬¡rt_thread_detach()֮ǰ
+*              3) rt_thread_detach()ֻὫ̴߳RTTں˶suspend_threadƳ,֪OS_QPendList
+*                 /߶еRingWaitPtr.OSTaskCreate()PendObjPtrֱҵȴOS_Q,
+*                 RTTԭ߳(ͨOSTaskDel()ɾԭ߳)ûOS_TCB,ֻOSQListв
+************************************************************************************************************************
+*/
+
+void  OS_TaskPendDel (rt_thread_t  thread)
+{
+    rt_list_t                     *p_obj_node;
+    rt_list_t                     *p_node;
+    OS_TCB                        *p_tcb;
+    OS_Q                          *p_q;
+    OS_PEND_DATA                  *p_pend_data;
+
+
+    /*ѳʱδеԹڵȴб,˲ֻ̬*/
+    p_tcb = OS_TCB_GET(thread);
+    if(p_tcb != RT_NULL)
+    {
+        if(p_tcb->PendObjPtr == RT_NULL ||
+           rt_object_get_type((rt_object_t)p_tcb->PendObjPtr) != RT_Object_Class_MessageQueue)
+        {
+            return;
+        }
+        p_q = (OS_Q *)p_tcb->PendObjPtr;
+#if OS_CFG_Q_SPSC_EN > 0u
+        if(p_q->RingWaitPtr == thread)
+        {
+            p_q->RingWaitPtr = RT_NULL;
+        }
+#endif
+        p_pend_data = p_tcb->PendDataPtr;
+        if(p_pend_data != RT_NULL && p_pend_data->List.next != &p_pend_data->List)
+        {
+            OS_PendListRemove(&p_q->PendList, p_pend_data);
+        }
+        return;
+    }
+
+    for(p_obj_node  = OSQList.next;
+        p_obj_node != &OSQList;
+        p_obj_node  = p_obj_node->next)
+    {
+        p_q = rt_list_entry(p_obj_node, OS_Q, ListNode);
+#if OS_CFG_Q_SPSC_EN > 0u
+        if(p_q->RingWaitPtr == thread)
+        {
+            p_q->RingWaitPtr = RT_NULL;
+            return;
+        }
+#endif
+        for(p_node  = p_q->PendList.List.next;
+            p_node != &p_q->PendList.List;
+            p_node  = p_node->next)
+        {
+            p_pend_data = rt_list_entry(p_node, OS_PEND_DATA, List);
+            if(p_pend_data->TCBPtr == thread)
+            {
+                OS_PendListRemove(&p_q->PendList, p_pend_data);
+                return;
+            }
+        }
+    }
+}
+
+/*
+************************************************************************************************************************
+*                                    BLOCK THE CURRENT TASK ON ONE OF ITS BUILT-IN OBJECTS
+*
+* Description: This function is called to block the current task until one of its built-in objects (e.g. its message
+*              queue) is posted, the pend is aborted or the timeout expires.  Because the receiver is known, no wait list
+*              is needed: the poster finds the task through its OS_TCB.
+*
+* Arguments  : p_tcb         is a pointer to the OS_TCB of the current task
+*
+*              pend_on       is the built-in object the task waits on (OS_TASK_PEND_ON_xxx)
+*
+*              time          RTTĳʱʱ:RT_WAITING_FOREVERʾõȴ,0ʾȴtick
+*
+*              cpu_sr        ÷ͨCPU_CRITICAL_ENTER()жʱCPU״̬
+*
+* Returns    : none. ȴp_tcb->PendStatus
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) ڹжϵ״̬µ,ڲῪжϲ,ʱж״̬ѻָΪcpu_sr
+*              3) ָк,p_tcb->PendOnδͶݷ,˵ǳʱʽ
+************************************************************************************************************************
+*/
+
+void  OS_TaskBlock (OS_TCB      *p_tcb,
+                    OS_STATE     pend_on,
+                    rt_int32_t   time,
+                    CPU_SR       cpu_sr)
+{
+    rt_thread_t  thread;
+
+
+    thread = &p_tcb->Task;
+
+    p_tcb->PendOn     = pend_on;
+    p_tcb->PendStatus = OS_STATUS_PEND_OK;
+
+    thread->error = RT_EOK;
+    rt_thread_suspend(thread);
+    if(time > 0)/*̶߳ʱгʱʱ*/
+    {
+        rt_timer_control(&(thread->thread_timer), RT_TIMER_CTRL_SET_TIME, &time);
+        rt_timer_start(&(thread->thread_timer));
+    }
+    CPU_CRITICAL_EXIT();
+
+    rt_schedule();
+
+    CPU_CRITICAL_ENTER();
+    if(p_tcb->PendOn == pend_on)/*ûбͶݷ*/
+    {
+        p_tcb->PendOn = OS_TASK_PEND_ON_NOTHING;
+        if(thread->error == -RT_ETIMEOUT)
+        {
+            p_tcb->PendStatus = OS_STATUS_PEND_TIMEOUT;
+        }
+        else
+        {
+            p_tcb->PendStatus = OS_STATUS_PEND_ABORT;
+        }
+    }
+    CPU_CRITICAL_EXIT();
+}
+
+/*
+************************************************************************************************************************
+*                                       READY A TASK WAITING ON ONE OF ITS BUILT-IN OBJECTS
+*
+* Description: This function is called to make a task blocked by OS_TaskBlock() ready to run.
+*
+* Arguments  : p_tcb         is a pointer to the OS_TCB of the task to ready
+*
+*              pend_on       is the built-in object being posted (OS_TASK_PEND_ON_xxx)
+*
+*              status        is the pend status to hand to the task (OS_STATUS_PEND_OK or OS_STATUS_PEND_ABORT)
+*
+* Returns    : DEF_TRUE      if the task was waiting on 'pend_on' and has been readied
+*              DEF_FALSE     if the task was not waiting on 'pend_on'
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) ڹжϵ״̬µ,ᴥ.ҪϢӦڵǰдOS_TCB
+************************************************************************************************************************
+*/
+
+CPU_BOOLEAN  OS_TaskRdy (OS_TCB     *p_tcb,
+                         OS_STATE    pend_on,
+                         OS_STATUS   status)
+{
+    if(p_tcb->PendOn != pend_on)
+    {
+        return DEF_FALSE;
+    }
+    p_tcb->PendOn     = OS_TASK_PEND_ON_NOTHING;
+    p_tcb->PendStatus = status;
+    rt_thread_resume(&p_tcb->Task);/*ѳʱ,᷵ش,ԻõεĽ*/
+    return DEF_TRUE;
+}
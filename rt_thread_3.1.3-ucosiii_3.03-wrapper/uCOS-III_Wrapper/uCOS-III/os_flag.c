@@ -117,14 +117,15 @@ void  OSFlagCreate (OS_FLAG_GRP  *p_grp,
     }  
     
     /*жں˶ǷѾ¼־飬ǷѾ*/
-    if(rt_object_get_type(&p_grp->parent.parent) == RT_Object_Class_Event)
+    if(rt_object_get_type(&p_grp->Grp.parent.parent) == RT_Object_Class_Event)
     {
         *p_err = OS_ERR_OBJ_CREATED;
         return;       
     }   
 
     /*uCOS¼ֱӱ뵽,ȼ*/
-    rt_err = rt_event_init(p_grp,(const char*)p_name,RT_IPC_FLAG_FIFO);
+    rt_err = rt_event_init(&p_grp->Grp,(const char*)p_name,RT_IPC_FLAG_FIFO);
+    p_grp->TS = (CPU_TS)0;
     
     *p_err = _err_rtt_to_ucosiii(rt_err);
 }
@@ -190,7 +191,7 @@ OS_OBJ_QTY  OSFlagDel (OS_FLAG_GRP  *p_grp,
     }
     
     /*жں˶ǷΪ¼־*/
-    if(rt_object_get_type(&p_grp->parent.parent) != RT_Object_Class_Event)
+    if(rt_object_get_type(&p_grp->Grp.parent.parent) != RT_Object_Class_Event)
     {
         *p_err = OS_ERR_OBJ_TYPE;
         return 0;       
@@ -204,7 +205,7 @@ OS_OBJ_QTY  OSFlagDel (OS_FLAG_GRP  *p_grp,
         return 0;
     }    
     
-    rt_err = rt_event_detach(p_grp);
+    rt_err = rt_event_detach(&p_grp->Grp);
     
     *p_err = _err_rtt_to_ucosiii(rt_err);
     return 0;/*ֵ,RTTûʵֲ鿴¼־黹мڵȴAPIֻܷ0*/
@@ -255,7 +256,7 @@ OS_OBJ_QTY  OSFlagDel (OS_FLAG_GRP  *p_grp,
 *                            then you will not get the timestamp.  In other words, passing a NULL pointer is valid and
 *                            indicates that you don't need the timestamp.
 *                            -------------˵-------------
-*                            òRTTû,NULL
+*                            ʱ¼־һαͶݵʱ(OS_TS_GET()ֵ);ʱʱΪ0
 *
 *              p_err         is a pointer to an error code and can be:
 *
@@ -294,7 +295,10 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
     rt_uint8_t      rt_option;
     rt_uint32_t     recved;
     
-    (void)p_ts;
+    if(p_ts != RT_NULL)
+    {
+        *p_ts = (CPU_TS)0;/*ʱʱʱΪ0*/
+    }
     
     /*Ƿж*/
     if(rt_interrupt_get_nest()!=0)
@@ -318,7 +322,7 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
     }   
     
     /*жں˶ǷΪ¼־*/
-    if(rt_object_get_type(&p_grp->parent.parent) != RT_Object_Class_Event)
+    if(rt_object_get_type(&p_grp->Grp.parent.parent) != RT_Object_Class_Event)
     {
         *p_err = OS_ERR_OBJ_TYPE;
         return ((OS_OBJ_QTY)0);       
@@ -398,11 +402,15 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
     }
     
     
-    rt_err = rt_event_recv(p_grp,
+    rt_err = rt_event_recv(&p_grp->Grp,
                            flags,
                            rt_option,
                            time,
                            &recved);
+    if(rt_err == RT_EOK && p_ts != RT_NULL)
+    {
+        *p_ts = p_grp->TS;
+    }
     *p_err = _err_rtt_to_ucosiii(rt_err);
     
     return recved;
@@ -499,6 +507,10 @@ OS_OBJ_QTY  OSFlagPendAbort (OS_FLAG_GRP  *p_grp,
 *                             -------------˵-------------
 *                             uCOSпûѡ1Ϊ¼0Ϊ¼RTTֱӶ
 *                             1Ϊ¼,˸λû,ֱOS_OPT_POST_FLAG_SET
+*                             ¼־Ͷݱǹ㲥:һιжоȫĵȴ,ֻ֮һ,
+*                             ҲԼOS_OPT_POST_ALL,Чͬ
+*                             RTTrt_event_sendͺض,¼ķɼݲ㰴rt_event_send߼ʵ,
+*                             OS_OPT_POST_NO_SCHEDʱֻȴ,֮OSSched()򲻴ѡͶͳһ
 *
 *              p_err         is a pointer to an error code and can be:
 *
@@ -506,6 +518,7 @@ OS_OBJ_QTY  OSFlagPendAbort (OS_FLAG_GRP  *p_grp,
 *                                OS_ERR_OBJ_PTR_NULL        You passed a NULL pointer
 *                                OS_ERR_OBJ_TYPE            You are not pointing to an event flag group
 *                                OS_ERR_OPT_INVALID         You specified an invalid option
+*                                OS_ERR_INT_Q_FULL          If the post was deferred but the ISR queue is full (ӳٷʱ)
 *                            -------------˵-------------
 *                                OS_ERR_XXXX        ʾԼuCOS-IIIԭĴ
 *                              - OS_ERR_XXXX        ʾôڱݲѾ޷ʹ
@@ -523,9 +536,15 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP  *p_grp,
                       OS_OPT        opt,
                       OS_ERR       *p_err)
 {
-    rt_err_t rt_err;
+    rt_list_t    *n;
+    rt_thread_t   thread;
+    rt_bool_t     need_schedule;
+    rt_err_t      status;
+    OS_FLAGS      flags_cur;
+    CPU_TS        ts;
+    CPU_SR_ALLOC();
     
-    (void)opt;
+    ts = OS_TS_GET();/*Ͷݵʱ*/
     
     /*ָǷΪ*/
     if(p_grp == RT_NULL)
@@ -535,14 +554,71 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP  *p_grp,
     }
     
     /*жں˶ǷΪ¼־*/
-    if(rt_object_get_type(&p_grp->parent.parent) != RT_Object_Class_Event)
+    if(rt_object_get_type(&p_grp->Grp.parent.parent) != RT_Object_Class_Event)
     {
         *p_err = OS_ERR_OBJ_TYPE;
         return 0;       
     }  
     
-    rt_err = rt_event_send(p_grp,flags);
-    *p_err = _err_rtt_to_ucosiii(rt_err);
+    if(flags == 0)/*rt_event_sendһ*/
+    {
+        *p_err = OS_ERR_RT_ERROR;
+        return p_grp->Grp.set;
+    }
+    
+#if OS_CFG_ISR_POST_DEFERRED_EN > 0u
+    if(rt_interrupt_get_nest()!=0)/*жֻдж϶,ж϶дͶ*/
+    {
+        OS_IntQPost((OS_OBJ_TYPE)RT_Object_Class_Event, (void *)p_grp, (void *)0, 0, flags, opt, p_err);
+        return 0;
+    }
+#endif
+    
+    need_schedule = RT_FALSE;
+    
+    CPU_CRITICAL_ENTER();
+    p_grp->Grp.set |= flags;
+    p_grp->TS = ts;
+    n = p_grp->Grp.parent.suspend_thread.next;
+    while(n != &(p_grp->Grp.parent.suspend_thread))/*ÿһȴǷ*/
+    {
+        thread = rt_list_entry(n, struct rt_thread, tlist);
+        status = -RT_ERROR;
+        if(thread->event_info & RT_EVENT_FLAG_AND)
+        {
+            if((thread->event_set & p_grp->Grp.set) == thread->event_set)
+            {
+                status = RT_EOK;
+            }
+        }
+        else if(thread->event_info & RT_EVENT_FLAG_OR)
+        {
+            if(thread->event_set & p_grp->Grp.set)
+            {
+                thread->event_set = thread->event_set & p_grp->Grp.set;/*¼ʵ¼*/
+                status = RT_EOK;
+            }
+        }
+        
+        n = n->next;/*rt_thread_resumeὫӹƳ,Ҫȡһڵ*/
+        if(status == RT_EOK)
+        {
+            if(thread->event_info & RT_EVENT_FLAG_CLEAR)
+            {
+                p_grp->Grp.set &= ~thread->event_set;
+            }
+            rt_thread_resume(thread);/*ֻ,*/
+            need_schedule = RT_TRUE;
+        }
+    }
+    flags_cur = p_grp->Grp.set;
+    CPU_CRITICAL_EXIT();
+    
+    if((opt & OS_OPT_POST_NO_SCHED) == 0 && need_schedule == RT_TRUE)
+    {
+        OSSched();/*ֻһ*/
+    }
     
-    return p_grp->set;/*ִк¼־ֵ*/
+    *p_err = OS_ERR_NONE;
+    return flags_cur;/*ִк¼־ֵ*/
 }
@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2020-07-12     Meco Man     the first verion
+ */
+
+/*
+************************************************************************************************************************
+*                                                      uC/OS-III
+*                                                 The Real-Time Kernel
+*
+*                                  (c) Copyright 2009-2012; Micrium, Inc.; Weston, FL
+*                           All rights reserved.  Protected by international copyright laws.
+*
+*                                                ISR QUEUE MANAGEMENT
+*
+* File    : OS_INT.C
+* By      : JJL
+* Version : V3.03.00
+*
+* LICENSING TERMS:
+* ---------------
+*           uC/OS-III is provided in source form for FREE short-term evaluation, for educational use or 
+*           for peaceful research.  If you plan or intend to use uC/OS-III in a commercial application/
+*           product then, you need to contact Micrium to properly license uC/OS-III for its use in your 
+*           application/product.   We provide ALL the source code for your convenience and to help you 
+*           experience uC/OS-III.  The fact that the source is provided does NOT mean that you can use 
+*           it commercially without paying a licensing fee.
+*
+*           Knowledge of the source code may NOT be used to develop a similar product.
+*
+*           Please help us continue to provide the embedded community with the finest software available.
+*           Your honesty is greatly appreciated.
+*
+*           You can contact us at www.micrium.com, or by phone at +1 (954) 217-2036.
+************************************************************************************************************************
+*/
+
+#include <os.h>
+
+/*
+жӳٷ(deferred post)˵:
+    Ĭ,жеOSSemPost/OSQPost/OSFlagPostжֱӾȴ,жϵʱȴ
+    os_cfg.hеOS_CFG_ISR_POST_DEFERRED_ENΪ1,жеͶֻһ¼дж϶OSIntQ,
+    ȼ(RTTȼ0)ж϶д,Ͷڸ,жйжϵʱΪ
+    ж϶еĴСOS_CFG_INT_Q_SIZE,ͨOSIntQNbrEntriesMaxOSIntQOvfCtr۲зֵ
+    ӳٷʱ,ȴͨp_tsõʱж϶дͶݵʱ,жϷʱ
+    ʹǰȵOSInit
+*/
+
+#if OS_CFG_ISR_POST_DEFERRED_EN > 0u
+
+OS_INT_Q      *OSIntQInPtr;                                 /* Pointer to the next entry to insert                    */
+OS_INT_Q      *OSIntQOutPtr;                                /* Pointer to the next entry to extract                   */
+OS_OBJ_QTY     OSIntQNbrEntries;                            /* Number of entries in the ISR queue                     */
+OS_OBJ_QTY     OSIntQNbrEntriesMax;                         /* Peak number of entries in the ISR queue                */
+OS_OBJ_QTY     OSIntQOvfCtr;                                /* Number of posts lost because the ISR queue was full    */
+
+static  OS_INT_Q          OSCfg_IntQ[OS_CFG_INT_Q_SIZE];    /* ж϶еĴ洢ռ                                     */
+
+ALIGN(RT_ALIGN_SIZE)
+static  rt_uint8_t        OSCfg_IntQTaskStk[OS_CFG_INT_Q_TASK_STK_SIZE];
+static  struct rt_thread  OSIntQTaskTCB;                    /* ж϶д                                       */
+
+/*
+************************************************************************************************************************
+*                                   POST TO ISR QUEUE
+*
+* Description: This function places contents of posts into an intermediate queue to help defer processing of interrupts
+*              at the task level.
+*
+* Arguments  : type       is the type of kernel object the post is destined to (RTTں˶):
+*
+*                             RT_Object_Class_Semaphore
+*                             RT_Object_Class_MessageQueue
+*                             RT_Object_Class_Event
+*                             OS_OBJ_TYPE_TASK_MSG
+*                             OS_OBJ_TYPE_TASK_SIGNAL
+*
+*              p_obj      is a pointer to the kernel object to post to.  This can be a pointer to a semaphore,
+*              -----      a message queue or an event flag group.
+*
+*              p_void     is a pointer to a message that is being posted.  This is used when posting to a message
+*                         queue.
+*
+*              msg_size   is the message size (in bytes) if posting to a message queue.
+*
+*              flags      the flag settings in case of an event flag group.
+*
+*              opt        the post option(s) to pass to the post function
+*
+*              p_err      is a pointer to an error return code:
+*
+*                             OS_ERR_NONE               if the post was deferred
+*                             OS_ERR_INT_Q_FULL         if the ISR queue is full and cannot accepts any further posts.  This
+*                                                       is generally an indication that you are posting too many events and
+*                                                       the ISR handler task is not able to process them or, the ISR queue
+*                                                       is not large enough.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) жϵʱȴ޹,Ϊдһ¼Լĳʱ
+*              3) rt_schedule():жRTTֻһPendSV,жϷغл,
+*                 ˼ʹжϽrt_interrupt_leave()˳(SysTick_Handler),ͶҲϵһȵ
+************************************************************************************************************************
+*/
+
+void  OS_IntQPost (OS_OBJ_TYPE   type,
+                   void         *p_obj,
+                   void         *p_void,
+                   OS_MSG_SIZE   msg_size,
+                   OS_FLAGS      flags,
+                   OS_OPT        opt,
+                   OS_ERR       *p_err)
+{
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();
+    if(OSIntQNbrEntries < OS_CFG_INT_Q_SIZE)                /* Make sure we haven't already filled the ISR queue      */
+    {
+        OSIntQNbrEntries++;
+
+        if(OSIntQNbrEntriesMax < OSIntQNbrEntries)
+        {
+            OSIntQNbrEntriesMax = OSIntQNbrEntries;
+        }
+
+        OSIntQInPtr->Type       = type;                     /* Save object type being posted                          */
+        OSIntQInPtr->ObjPtr     = p_obj;                    /* Save pointer to object being posted                    */
+        OSIntQInPtr->MsgPtr     = p_void;                   /* Save pointer to message if posting to a message queue  */
+        OSIntQInPtr->MsgSize    = msg_size;                 /* Save the message size   if posting to a message queue  */
+        OSIntQInPtr->Flags      = flags;                    /* Save the flags if posting to an event flag group       */
+        OSIntQInPtr->Opt        = opt;                      /* Save post options                                      */
+        OSIntQInPtr             = OSIntQInPtr->NextPtr;     /* Point to the next interrupt handler queue entry        */
+
+        if((OSIntQTaskTCB.stat & RT_THREAD_STAT_MASK) == RT_THREAD_SUSPEND)
+        {
+            rt_thread_resume(&OSIntQTaskTCB);               /* Make the ISR handler task ready to run                 */
+        }
+        CPU_CRITICAL_EXIT();
+        rt_schedule();                                      /* ж϶OSIntExit()˳,һε     */
+       *p_err = OS_ERR_NONE;
+    }
+    else
+    {
+        OSIntQOvfCtr++;                                     /* Count the number of ISR queue overflows                */
+        CPU_CRITICAL_EXIT();
+       *p_err = OS_ERR_INT_Q_FULL;
+    }
+}
+
+/*
+************************************************************************************************************************
+*                                               INTERRUPT QUEUE MANAGEMENT TASK
+*
+* Description: This task is created by OSInit() and performs the posts that were deferred by ISRs.
+*
+* Arguments  : p_arg    is a pointer to an optional argument that is passed during task creation.  For this function
+*                       the argument is not used and will be a NULL pointer.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) ݵOSSemPost/OSQPost/OSFlagPost,Щٴдж϶
+************************************************************************************************************************
+*/
+
+static  void  OS_IntQTask (void  *p_arg)
+{
+    OS_INT_Q     *p_int_q;
+    OS_ERR        err;
+    rt_thread_t   thread;
+    CPU_SR_ALLOC();
+
+
+    (void)p_arg;
+    thread = rt_thread_self();
+    while(DEF_ON)
+    {
+        CPU_CRITICAL_ENTER();
+        if(OSIntQNbrEntries == (OS_OBJ_QTY)0u)              /* Nothing to do, wait until an ISR posts                 */
+        {
+            rt_thread_suspend(thread);
+            CPU_CRITICAL_EXIT();
+            rt_schedule();
+            continue;
+        }
+        p_int_q = OSIntQOutPtr;                             /* The entry can't be overwritten until NbrEntries--      */
+        CPU_CRITICAL_EXIT();
+
+        switch(p_int_q->Type)                               /* Re-post to task                                        */
+        {
+            case RT_Object_Class_Semaphore:
+                 (void)OSSemPost((OS_SEM *)p_int_q->ObjPtr,
+                                 p_int_q->Opt,
+                                 &err);
+                 break;
+
+            case RT_Object_Class_MessageQueue:
+                 OSQPost((OS_Q *)p_int_q->ObjPtr,
+                         p_int_q->MsgPtr,
+                         p_int_q->MsgSize,
+                         p_int_q->Opt,
+                         &err);
+                 break;
+
+            case RT_Object_Class_Event:
+                 (void)OSFlagPost((OS_FLAG_GRP *)p_int_q->ObjPtr,
+                                  p_int_q->Flags,
+                                  p_int_q->Opt,
+                                  &err);
+                 break;
+
+#if OS_CFG_TASK_Q_EN > 0u
+            case OS_OBJ_TYPE_TASK_MSG:
+                 OSTaskQPost((OS_TCB *)p_int_q->ObjPtr,
+                             p_int_q->MsgPtr,
+                             p_int_q->MsgSize,
+                             p_int_q->Opt,
+                             &err);
+                 break;
+#endif
+
+            case OS_OBJ_TYPE_TASK_SIGNAL:
+                 (void)OSTaskSemPost((OS_TCB *)p_int_q->ObjPtr,
+                                     p_int_q->Opt,
+                                     &err);
+                 break;
+
+            default:
+                 break;
+        }
+
+        CPU_CRITICAL_ENTER();
+        OSIntQOutPtr = p_int_q->NextPtr;                    /* Point to next item in the ISR queue                    */
+        OSIntQNbrEntries--;                                 /* One less entry in the queue                            */
+        CPU_CRITICAL_EXIT();
+    }
+}
+
+/*
+************************************************************************************************************************
+*                                                 INITIALIZE THE ISR QUEUE
+*
+* Description: This function is called by OSInit() to initialize the ISR queue and to create the ISR handler task.
+*
+* Arguments  : p_err    is a pointer to a variable that will contain an error code returned by this function.
+*
+*                           OS_ERR_NONE             the ISR queue was initialized and the handler task created
+*                           OS_ERR_INT_Q_SIZE       if OS_CFG_INT_Q_SIZE is smaller than 2
+*                         + OS_ERR_RT_ERROR         if the ISR handler task could not be created
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+************************************************************************************************************************
+*/
+
+void  OS_IntQTaskInit (OS_ERR  *p_err)
+{
+    OS_INT_Q     *p_int_q;
+    OS_INT_Q     *p_int_q_next;
+    OS_OBJ_QTY    i;
+    rt_err_t      rt_err;
+
+
+    OSIntQOvfCtr = (OS_OBJ_QTY)0u;                          /* Clear the ISR queue overflow counter                   */
+
+    if(OS_CFG_INT_Q_SIZE < 2u)
+    {
+       *p_err = OS_ERR_INT_Q_SIZE;
+        return;
+    }
+
+    p_int_q      = &OSCfg_IntQ[0];                          /* Initialize the circular ISR queue                      */
+    p_int_q_next = p_int_q;
+    p_int_q_next++;
+    for(i = 0u; i < OS_CFG_INT_Q_SIZE; i++)
+    {
+        p_int_q->Type    = RT_Object_Class_Null;
+        p_int_q->NextPtr = p_int_q_next;
+        p_int_q->ObjPtr  = (void      *)0;
+        p_int_q->MsgPtr  = (void      *)0;
+        p_int_q->MsgSize = (OS_MSG_SIZE)0u;
+        p_int_q->Flags   = (OS_FLAGS   )0u;
+        p_int_q->Opt     = (OS_OPT     )0u;
+        p_int_q++;
+        p_int_q_next++;
+    }
+    p_int_q--;
+    p_int_q->NextPtr = &OSCfg_IntQ[0];                      /* Last entry points back to the first one                */
+
+    OSIntQInPtr         = &OSCfg_IntQ[0];
+    OSIntQOutPtr        = &OSCfg_IntQ[0];
+    OSIntQNbrEntries    = (OS_OBJ_QTY)0u;
+    OSIntQNbrEntriesMax = (OS_OBJ_QTY)0u;
+
+    rt_err = rt_thread_init(&OSIntQTaskTCB,                 /* Create the ISR handler task at the highest priority    */
+                            "os_intq",
+                            OS_IntQTask,
+                            RT_NULL,
+                            &OSCfg_IntQTaskStk[0],
+                            sizeof(OSCfg_IntQTaskStk),
+                            0u,
+                            1u);
+    if(rt_err != RT_EOK)
+    {
+       *p_err = _err_rtt_to_ucosiii(rt_err);
+        return;
+    }
+    rt_thread_startup(&OSIntQTaskTCB);
+   *p_err = OS_ERR_NONE;
+}
+
+#endif
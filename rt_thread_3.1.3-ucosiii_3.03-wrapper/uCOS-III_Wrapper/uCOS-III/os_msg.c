@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2020-07-12     Meco Man     the first verion
+ */
+
+/*
+************************************************************************************************************************
+*                                                      uC/OS-III
+*                                                 The Real-Time Kernel
+*
+*                                  (c) Copyright 2009-2012; Micrium, Inc.; Weston, FL
+*                           All rights reserved.  Protected by international copyright laws.
+*
+*                                             MESSAGE HANDLING SERVICES
+*
+* File    : OS_MSG.C
+* By      : JJL
+* Version : V3.03.00
+*
+* LICENSING TERMS:
+* ---------------
+*           uC/OS-III is provided in source form for FREE short-term evaluation, for educational use or 
+*           for peaceful research.  If you plan or intend to use uC/OS-III in a commercial application/
+*           product then, you need to contact Micrium to properly license uC/OS-III for its use in your 
+*           application/product.   We provide ALL the source code for your convenience and to help you 
+*           experience uC/OS-III.  The fact that the source is provided does NOT mean that you can use 
+*           it commercially without paying a licensing fee.
+*
+*           Knowledge of the source code may NOT be used to develop a similar product.
+*
+*           Please help us continue to provide the embedded community with the finest software available.
+*           Your honesty is greatly appreciated.
+*
+*           You can contact us at www.micrium.com, or by phone at +1 (954) 217-2036.
+************************************************************************************************************************
+*/
+
+#include <os.h>
+
+/*
+Ϣص˵:
+    ϢйһȫϢ,Сos_cfg.hеOS_CFG_MSG_POOL_SIZE̬
+    Ϣеmax_qtyʾöԹҶϢ,ʱٴڴа󳤶ȷռ,
+    ϢصĴСӦжͬʱѹϢʵʷֵ,ͨOSMsgPool.NbrUsedMax۲÷ֵ
+    ͨOSQCreateStatic()Ϣʹõ÷ṩOS_MSGΪ˽Ϣ,ռȫϢ;
+    Ϣжַʽ,ԽOS_CFG_MSG_POOL_SIZEΪ0,ʱٶȫϢصĴ洢ռ
+    ļеĺΪڲ,OS_MsgPoolInitⶼڹжϵ״̬µ
+*/
+
+OS_MSG_POOL   OSMsgPool;                                    /* Pool of OS_MSG                                         */
+
+#if OS_CFG_MSG_POOL_SIZE > 0u
+static  OS_MSG  OSCfg_MsgPool[OS_CFG_MSG_POOL_SIZE];        /* ϢصĴ洢ռ                                       */
+#endif
+
+/*
+************************************************************************************************************************
+*                                            CREATE A POOL OF 'OS_MSG'
+*
+* Description: This function is called to link an array of OS_MSGs into the free list of a message pool.
+*
+* Argument(s): p_pool    is a pointer to the message pool to create
+*
+*              p_msg_tbl is a pointer to the array of OS_MSGs that will be placed in the free list
+*
+*              qty       is the number of entries in 'p_msg_tbl'
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+************************************************************************************************************************
+*/
+
+void  OS_MsgPoolCreate (OS_MSG_POOL  *p_pool,
+                        OS_MSG       *p_msg_tbl,
+                        OS_MSG_QTY    qty)
+{
+    OS_MSG      *p_msg1;
+    OS_MSG      *p_msg2;
+    OS_MSG_QTY   i;
+    OS_MSG_QTY   loops;
+
+
+    p_msg1 = p_msg_tbl;
+    p_msg2 = p_msg_tbl;
+    p_msg2++;
+    loops  = qty - 1u;
+    for(i = 0u; i < loops; i++)                             /* Init. list of free OS_MSGs                             */
+    {
+        p_msg1->NextPtr = p_msg2;
+        p_msg1->MsgPtr  = (void      *)0;
+        p_msg1->MsgSize = (OS_MSG_SIZE)0u;
+        p_msg1->MsgTS   = (CPU_TS)0;
+        p_msg1++;
+        p_msg2++;
+    }
+    p_msg1->NextPtr = (OS_MSG    *)0;                       /* Last OS_MSG                                            */
+    p_msg1->MsgPtr  = (void      *)0;
+    p_msg1->MsgSize = (OS_MSG_SIZE)0u;
+    p_msg1->MsgTS   = (CPU_TS)0;
+
+    p_pool->NextPtr    = p_msg_tbl;                         /* Initialize the pool of OS_MSGs                         */
+    p_pool->NbrFree    = qty;
+    p_pool->NbrUsed    = (OS_MSG_QTY)0;
+    p_pool->NbrUsedMax = (OS_MSG_QTY)0;
+}
+
+/*
+************************************************************************************************************************
+*                                          INITIALIZE THE POOL OF 'OS_MSG'
+*
+* Description: This function is called by OSInit() to initialize the free list of OS_MSGs.
+*
+* Argument(s): p_err     is a pointer to a variable that will contain an error code returned by this function.
+*
+*                            OS_ERR_NONE
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+************************************************************************************************************************
+*/
+
+void  OS_MsgPoolInit (OS_ERR  *p_err)
+{
+#if OS_CFG_MSG_POOL_SIZE > 0u
+    OS_MsgPoolCreate(&OSMsgPool, &OSCfg_MsgPool[0], (OS_MSG_QTY)OS_CFG_MSG_POOL_SIZE);
+#else
+    OSMsgPool.NextPtr    = (OS_MSG    *)0;                  /* ûȫϢ,ֻʹOSQCreateStatic()Ϣ  */
+    OSMsgPool.NbrFree    = (OS_MSG_QTY)0;
+    OSMsgPool.NbrUsed    = (OS_MSG_QTY)0;
+    OSMsgPool.NbrUsedMax = (OS_MSG_QTY)0;
+#endif
+   *p_err = OS_ERR_NONE;
+}
+
+/*
+************************************************************************************************************************
+*                                        RELEASE ALL MESSAGE IN MESSAGE QUEUE
+*
+* Description: This function returns all the messages in a message queue to the free list.
+*
+* Arguments  : p_msg_q       is a pointer to the OS_MSG_Q structure containing messages to free.
+*              -------
+*
+* Returns    : the number of OS_MSGs returned to the free list
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) ϢһԽӻϢصıͷ,еϢ޹
+************************************************************************************************************************
+*/
+
+OS_MSG_QTY  OS_MsgQFreeAll (OS_MSG_Q  *p_msg_q)
+{
+    OS_MSG       *p_msg;
+    OS_MSG_POOL  *p_pool;
+    OS_MSG_QTY    qty;
+
+
+    qty = p_msg_q->NbrEntries;                              /* Get the number of OS_MSGs being freed                  */
+    if(p_msg_q->NbrEntries > (OS_MSG_QTY)0)
+    {
+        p_pool                  = p_msg_q->PoolPtr;
+        p_msg                   = p_msg_q->InPtr;           /* Point to end of message chain                          */
+        p_msg->NextPtr          = p_pool->NextPtr;
+        p_pool->NextPtr         = p_msg_q->OutPtr;          /* Point to beginning of message chain                    */
+        p_pool->NbrUsed        -= p_msg_q->NbrEntries;      /* Update statistics for free list of messages            */
+        p_pool->NbrFree        += p_msg_q->NbrEntries;
+        p_msg_q->NbrEntries     = (OS_MSG_QTY)0;            /* Flush the message queue                                */
+        p_msg_q->InPtr          = (OS_MSG   *)0;
+        p_msg_q->OutPtr         = (OS_MSG   *)0;
+    }
+    return (qty);
+}
+
+/*
+************************************************************************************************************************
+*                                               INITIALIZE A MESSAGE QUEUE
+*
+* Description: This function is called to initialize a message queue
+*
+* Arguments  : p_msg_q      is a pointer to the message queue to initialize
+*              -------
+*
+*              p_pool        is a pointer to the message pool the OS_MSGs of this queue will be taken from
+*
+*              size          is the maximum number of entries that a message queue can have.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+************************************************************************************************************************
+*/
+
+void  OS_MsgQInit (OS_MSG_Q     *p_msg_q,
+                   OS_MSG_POOL  *p_pool,
+                   OS_MSG_QTY    size)
+{
+    p_msg_q->PoolPtr        = p_pool;
+    p_msg_q->NbrEntriesSize = (OS_MSG_QTY)size;
+    p_msg_q->NbrEntries     = (OS_MSG_QTY)0;
+    p_msg_q->NbrEntriesMax  = (OS_MSG_QTY)0;
+    p_msg_q->InPtr          = (OS_MSG   *)0;
+    p_msg_q->OutPtr         = (OS_MSG   *)0;
+}
+
+/*
+************************************************************************************************************************
+*                                           RETRIEVE MESSAGE FROM MESSAGE QUEUE
+*
+* Description: This function retrieves a message from a message queue
+*
+* Arguments  : p_msg_q     is a pointer to the message queue where we want to extract the message from
+*              -------
+*
+*              p_msg_size  is a pointer to where the size (in bytes) of the message will be placed
+*
+*              p_ts        is a pointer to where the time stamp will be placed
+*
+*              p_err       is a pointer to an error code that will be returned from this call.
+*
+*                              OS_ERR_Q_EMPTY
+*                              OS_ERR_NONE
+*
+* Returns    : The message (a pointer)
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) ڹжϵ״̬µ
+************************************************************************************************************************
+*/
+
+void  *OS_MsgQGet (OS_MSG_Q     *p_msg_q,
+                   OS_MSG_SIZE  *p_msg_size,
+                   CPU_TS       *p_ts,
+                   OS_ERR       *p_err)
+{
+    OS_MSG       *p_msg;
+    OS_MSG_POOL  *p_pool;
+    void         *p_void;
+
+
+    if(p_msg_q->NbrEntries == (OS_MSG_QTY)0)                /* Is the queue empty?                                    */
+    {
+       *p_msg_size = (OS_MSG_SIZE)0;                        /* Yes                                                    */
+        if(p_ts != (CPU_TS *)0)
+        {
+           *p_ts  = (CPU_TS)0;
+        }
+       *p_err      =  OS_ERR_Q_EMPTY;
+        return ((void *)0);
+    }
+
+    p_msg           = p_msg_q->OutPtr;                      /* No, get the next message to extract from the queue     */
+    p_void          = p_msg->MsgPtr;
+   *p_msg_size      = p_msg->MsgSize;
+    if(p_ts != (CPU_TS *)0)
+    {
+       *p_ts        = p_msg->MsgTS;
+    }
+
+    p_msg_q->OutPtr = p_msg->NextPtr;                       /* Point to next message to extract                       */
+
+    if(p_msg_q->OutPtr == (OS_MSG *)0)                      /* Are there any more messages in the queue?              */
+    {
+        p_msg_q->InPtr      = (OS_MSG   *)0;                /* No                                                     */
+        p_msg_q->NbrEntries = (OS_MSG_QTY)0;
+    }
+    else
+    {
+        p_msg_q->NbrEntries--;                              /* Yes, One less message in the queue                     */
+    }
+
+    p_pool          = p_msg_q->PoolPtr;
+    p_msg->NextPtr  = p_pool->NextPtr;                      /* Return message control block to free list              */
+    p_pool->NextPtr = p_msg;
+    p_pool->NbrFree++;
+    p_pool->NbrUsed--;
+
+   *p_err             = OS_ERR_NONE;
+    return (p_void);
+}
+
+/*
+************************************************************************************************************************
+*                                           DEPOSIT MESSAGE IN MESSAGE QUEUE
+*
+* Description: This function places a message in a message queue
+*
+* Arguments  : p_msg_q     is a pointer to the OS_MSG_Q
+*              -------
+*
+*              p_void      is a pointer to the message to deposit
+*
+*              msg_size    is the size of the message (in bytes)
+*
+*              opt         specifies whether the message will be posted in FIFO or LIFO order
+*
+*                              OS_OPT_POST_FIFO
+*                              OS_OPT_POST_LIFO
+*
+*              ts          is the timestamp used to determine when the message was placed in the queue
+*
+*              p_err       is a pointer to a variable that will contain an error code returned by this function.
+*
+*                              OS_ERR_Q_MAX              the queue is full
+*                              OS_ERR_MSG_POOL_EMPTY     we no longer have any OS_MSG to use
+*                              OS_ERR_NONE               the message was deposited in the queue
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) ڹжϵ״̬µ
+************************************************************************************************************************
+*/
+
+void  OS_MsgQPut (OS_MSG_Q     *p_msg_q,
+                  void         *p_void,
+                  OS_MSG_SIZE   msg_size,
+                  OS_OPT        opt,
+                  CPU_TS        ts,
+                  OS_ERR       *p_err)
+{
+    OS_MSG       *p_msg;
+    OS_MSG       *p_msg_in;
+    OS_MSG_POOL  *p_pool;
+
+
+    if(p_msg_q->NbrEntries >= p_msg_q->NbrEntriesSize)
+    {
+       *p_err = OS_ERR_Q_MAX;                               /* Message queue cannot accept any more messages          */
+        return;
+    }
+
+    p_pool = p_msg_q->PoolPtr;
+    if(p_pool->NbrFree == (OS_MSG_QTY)0)
+    {
+       *p_err = OS_ERR_MSG_POOL_EMPTY;                      /* No more OS_MSG to use                                  */
+        return;
+    }
+
+    p_msg           = p_pool->NextPtr;                      /* Remove message control block from free list            */
+    p_pool->NextPtr = p_msg->NextPtr;
+    p_pool->NbrFree--;
+    p_pool->NbrUsed++;
+    if(p_pool->NbrUsedMax < p_pool->NbrUsed)
+    {
+        p_pool->NbrUsedMax = p_pool->NbrUsed;
+    }
+
+    if(p_msg_q->NbrEntries == (OS_MSG_QTY)0)                /* Is this first message placed in the queue?             */
+    {
+        p_msg_q->InPtr         = p_msg;                     /* Yes                                                    */
+        p_msg_q->OutPtr        = p_msg;
+        p_msg_q->NbrEntries    = (OS_MSG_QTY)1;
+        p_msg->NextPtr         = (OS_MSG *)0;
+    }
+    else                                                    /* No                                                     */
+    {
+        if((opt & OS_OPT_POST_LIFO) == OS_OPT_POST_FIFO)    /* Is it FIFO or LIFO?                                    */
+        {
+            p_msg_in           = p_msg_q->InPtr;            /* FIFO, add to the head                                  */
+            p_msg_in->NextPtr  = p_msg;
+            p_msg_q->InPtr     = p_msg;
+            p_msg->NextPtr     = (OS_MSG *)0;
+        }
+        else
+        {
+            p_msg->NextPtr     = p_msg_q->OutPtr;           /* LIFO, add to the tail                                  */
+            p_msg_q->OutPtr    = p_msg;
+        }
+        p_msg_q->NbrEntries++;
+    }
+    if(p_msg_q->NbrEntriesMax < p_msg_q->NbrEntries)        /* Keep track of the peak number of entries               */
+    {
+        p_msg_q->NbrEntriesMax = p_msg_q->NbrEntries;
+    }
+    p_msg->MsgPtr  = p_void;                                /* Deposit message in the message queue entry             */
+    p_msg->MsgSize = msg_size;
+    p_msg->MsgTS   = ts;
+   *p_err          = OS_ERR_NONE;
+}
@@ -105,13 +105,14 @@ void  OSMutexCreate (OS_MUTEX  *p_mutex,
     }
     
     /*жں˶ǷѾźǷѾ*/
-    if(rt_object_get_type(&p_mutex->parent.parent) == RT_Object_Class_Mutex)
+    if(rt_object_get_type(&p_mutex->Mutex.parent.parent) == RT_Object_Class_Mutex)
     {
         *p_err = OS_ERR_OBJ_CREATED;
         return;       
     }    
 
-    rt_err = rt_mutex_init(p_mutex,(const char *)p_name,RT_IPC_FLAG_PRIO);/*uCOS-III֧ȼ*/
+    rt_err = rt_mutex_init(&p_mutex->Mutex,(const char *)p_name,RT_IPC_FLAG_PRIO);/*uCOS-III֧ȼ*/
+    p_mutex->TS = (CPU_TS)0;
     *p_err = _err_rtt_to_ucosiii(rt_err);
 }
 
@@ -182,7 +183,7 @@ OS_OBJ_QTY  OSMutexDel (OS_MUTEX  *p_mutex,
     }  
 
     /*жں˶ǷΪ*/
-    if(rt_object_get_type(&p_mutex->parent.parent) != RT_Object_Class_Mutex)
+    if(rt_object_get_type(&p_mutex->Mutex.parent.parent) != RT_Object_Class_Mutex)
     {
         *p_err = OS_ERR_OBJ_TYPE;
         return 0;       
@@ -196,7 +197,7 @@ OS_OBJ_QTY  OSMutexDel (OS_MUTEX  *p_mutex,
         return 0;
     }   
     
-    rt_err = rt_mutex_detach(p_mutex);
+    rt_err = rt_mutex_detach(&p_mutex->Mutex);
     *p_err = _err_rtt_to_ucosiii(rt_err);
     return 0;/*ֵ,RTTûʵֲ鿴ûмڵȴAPIֻܷ0*/
 }
@@ -224,7 +225,7 @@ OS_OBJ_QTY  OSMutexDel (OS_MUTEX  *p_mutex,
 *                            will not get the timestamp.  In other words, passing a NULL pointer is valid and indicates
 *                            that you don't need the timestamp.
 *                            -------------˵-------------
-*                            òRTTû,NULL
+*                            ûʱػһαͷŵʱ(OS_TS_GET()ֵ);ʱʱΪ0
 *
 *              p_err         is a pointer to a variable that will contain an error code returned by this function.
 *
@@ -261,8 +262,12 @@ void  OSMutexPend (OS_MUTEX  *p_mutex,
 {
     rt_int32_t time;
     rt_err_t rt_err;
+    OS_TCB *p_tcb;
     
-    (void)p_ts;
+    if(p_ts != RT_NULL)
+    {
+        *p_ts = (CPU_TS)0;/*ʱʱʱΪ0*/
+    }
     
     /*Ƿж*/
     if(rt_interrupt_get_nest()!=0)
@@ -286,7 +291,7 @@ void  OSMutexPend (OS_MUTEX  *p_mutex,
     }
     
     /*жں˶ǷΪ*/
-    if(rt_object_get_type(&p_mutex->parent.parent) != RT_Object_Class_Mutex)
+    if(rt_object_get_type(&p_mutex->Mutex.parent.parent) != RT_Object_Class_Mutex)
     {
         *p_err = OS_ERR_OBJ_TYPE;
         return;       
@@ -314,7 +319,20 @@ void  OSMutexPend (OS_MUTEX  *p_mutex,
         *p_err = OS_ERR_OPT_INVALID;/*optЧ*/
     }    
     
-    rt_err = rt_mutex_take(p_mutex,time);
+    p_tcb = OS_TCB_GET(rt_thread_self());
+    if(p_tcb != RT_NULL)
+    {
+        p_tcb->PendObjPtr = &p_mutex->Mutex;/*ȴڼ䱻޸ȼʱֻûĵȴб,OS_TaskChangePrio()*/
+    }
+    rt_err = rt_mutex_take(&p_mutex->Mutex,time);
+    if(p_tcb != RT_NULL)
+    {
+        p_tcb->PendObjPtr = RT_NULL;
+    }
+    if(rt_err == RT_EOK && p_ts != RT_NULL)
+    {
+        *p_ts = p_mutex->TS;
+    }
     *p_err = _err_rtt_to_ucosiii(rt_err);
 }
 
@@ -373,9 +391,10 @@ OS_OBJ_QTY  OSMutexPendAbort (OS_MUTEX  *p_mutex,
 *              opt      is an option you can specify to alter the behavior of the post.  The choices are:
 *
 *                           OS_OPT_POST_NONE        No special option selected
-*                         - OS_OPT_POST_NO_SCHED    If you don't want the scheduler to be called after the post.
+*                           OS_OPT_POST_NO_SCHED    If you don't want the scheduler to be called after the post.
 *                       -------------˵-------------
-*                        RTTûʵͷŻ󲻵ȣOS_OPT_POST_NO_SCHED
+*                        RTTrt_mutex_releaseͷźض,˻ͷɼݲ㰴rt_mutex_release߼ʵ,
+*                        OS_OPT_POST_NO_SCHED:ָֻȼȴ,֮OSSched()򲻴ѡͶͳһ
 *
 *              p_err    is a pointer to a variable that will contain an error code returned by this function.
 *
@@ -401,7 +420,12 @@ void  OSMutexPost (OS_MUTEX  *p_mutex,
                    OS_OPT     opt,
                    OS_ERR    *p_err)
 {
-    rt_err_t rt_err;
+    rt_thread_t  thread;
+    rt_bool_t    need_schedule;
+    CPU_TS       ts;
+    CPU_SR_ALLOC();
+    
+    ts = OS_TS_GET();/*ͷŵʱ*/
     
     /*Ƿж*/
     if(rt_interrupt_get_nest()!=0)
@@ -418,26 +442,65 @@ void  OSMutexPost (OS_MUTEX  *p_mutex,
     }  
     
     /*жں˶ǷΪź*/
-    if(rt_object_get_type(&p_mutex->parent.parent) != RT_Object_Class_Mutex)
+    if(rt_object_get_type(&p_mutex->Mutex.parent.parent) != RT_Object_Class_Mutex)
     {
         *p_err = OS_ERR_OBJ_TYPE;
         return;       
     }
     
-    /*optѡֻΪOS_OPT_POST_NONE*/
-    if(opt != OS_OPT_POST_NONE)
+    /*optѡֻΪOS_OPT_POST_NONEOS_OPT_POST_NO_SCHED*/
+    if(opt != OS_OPT_POST_NONE && opt != OS_OPT_POST_NO_SCHED)
     {
         *p_err = OS_ERR_OPT_INVALID;
         RT_DEBUG_LOG(RT_DEBUG_UCOSIII,("OSMutexPost: wrapper can't accept this option\r\n"));
         return;
     }    
     
-    rt_err = rt_mutex_release(p_mutex);
+    need_schedule = RT_FALSE;
+    thread = rt_thread_self();
     
-    *p_err = _err_rtt_to_ucosiii(rt_err);
+    CPU_CRITICAL_ENTER();
     /*ֻѾӵлȨ̲߳ͷ*/
-    if(rt_err == -RT_ERROR)/*rt_mutex_release-RT_ERRORʾ̷߳ջ߳*/
+    if(thread != p_mutex->Mutex.owner)
     {
+        CPU_CRITICAL_EXIT();
         *p_err = OS_ERR_MUTEX_NOT_OWNER;
+        return;
+    }
+    
+    p_mutex->Mutex.hold--;
+    if(p_mutex->Mutex.hold == 0)/*Ƕȫͷ*/
+    {
+        need_schedule = RT_TRUE;/*ȼָ򽻸ȴ,ǰܲȼ*/
+        p_mutex->TS = ts;
+        
+        /*ָȼ̳жȼ*/
+        if(p_mutex->Mutex.original_priority != p_mutex->Mutex.owner->current_priority)
+        {
+            rt_thread_control(p_mutex->Mutex.owner, RT_THREAD_CTRL_CHANGE_PRIORITY, &(p_mutex->Mutex.original_priority));
+        }
+        
+        if(!rt_list_isempty(&(p_mutex->Mutex.parent.suspend_thread)))/*ֱӽȼߵĵȴ*/
+        {
+            thread = rt_list_entry(p_mutex->Mutex.parent.suspend_thread.next, struct rt_thread, tlist);
+            p_mutex->Mutex.owner = thread;
+            p_mutex->Mutex.original_priority = thread->current_priority;
+            p_mutex->Mutex.hold++;
+            rt_thread_resume(thread);/*ֻ,*/
+        }
+        else
+        {
+            p_mutex->Mutex.value++;
+            p_mutex->Mutex.owner = RT_NULL;
+            p_mutex->Mutex.original_priority = 0xff;
+        }
+    }
+    CPU_CRITICAL_EXIT();
+    
+    if((opt & OS_OPT_POST_NO_SCHED) == 0 && need_schedule == RT_TRUE)
+    {
+        OSSched();
     }
+    
+    *p_err = OS_ERR_NONE;
 }
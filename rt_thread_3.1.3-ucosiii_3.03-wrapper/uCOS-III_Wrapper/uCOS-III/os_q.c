@@ -42,29 +42,37 @@
 
 #include <os.h>
 
+rt_list_t     OSQList = {&OSQList, &OSQList};               /* List of all the OS_Qs                                  */
+
 /*
-Ϣз(post/send)ѡ˵:
+Ϣʵַʽ˵:
     RTTϢuCOSϢʵֻȫͬ
-     RTTϢǲݿķʽֱݵĴ
+     RTTϢǲݿķʽֱݵĴ,ÿϢҪЯһϢͷ
      uCOSϢвôָ㿽ʽ
-    ȻRTTҲôָķʽûṩurgentLIFOϢ,˲RTTϢʵ
+    ˼ݲ㲻ٽRTTϢ,uCOS-IIIʵַʽ:
+     Ͷʱڵȴ,ֱӽϢȼߵĵȴ,ռϢ
+     ȫϢOSMsgPoolȡһOS_MSG"ָ+",ҵ,OS_OPT_POST_LIFOʱڶͷ
+     ȡʱȡһOS_MSG黹Ϣ,Ϊʱ밴ȼеĵȴб
+    ϢصĴСos_cfg.hеOS_CFG_MSG_POOL_SIZE,ʹǰȵOSInit
+    ҲͨOSQCreateStatic()ɵ÷ṩϢĴ洢ռ,ϢвռȫϢ
+    ÿϢʼͳƵǰ/ֵϢԼͶݡͶʧܡȡĴ,OSQStatReset()¿ʼͳ
+    OSQPostMulti()/OSQPendMulti()һβһιжͶ/ȡϢ,ڳշϢĳ
+    ֻһ(ͨж)һĳ,ͨOSQCreateSPSC()ĻλϢ,
+    Ͷʱж,ֻʱŹжϽ份
+    ÿϢͶʱʱ(OS_MSG.MsgTS),ֱӽʱOS_PEND_DATAȴ,OSQPend()p_ts
 
-    RTT֧֣
-        RT_IPC_FLAG_PRIO(uCOS-IIIûʵ)
-        RT_IPC_FLAG_FIFO(൱OS_OPT_POST_FIFO)
-        ͨrt_mq_urgentϢӵͷLIFO(൱OS_OPT_POST_LIFO)
     uCOS-III֧֣
-        OS_OPT_POST_FIFO(൱RT_IPC_FLAG_PRIO)
-        OS_OPT_POST_LIFO(൱rt_mq_urgent) 
-        OS_OPT_POST_ALL (RT-Threadδʵ)
-        OS_OPT_POST_NO_SCHED (RT-Threadδʵ)
+        OS_OPT_POST_FIFO
+        OS_OPT_POST_LIFO
+        OS_OPT_POST_ALL
+        OS_OPT_POST_NO_SCHED
 */
 
-/*
-RTTûؽӿڣºûʵ
-OSQFlush
-OSQPendAbort
-*/
+#if OS_CFG_Q_SPSC_EN > 0u
+static  void         OS_QRingPost  (OS_Q *p_q, void *p_void, OS_MSG_SIZE msg_size, OS_OPT opt, CPU_TS ts, OS_ERR *p_err);
+static  void        *OS_QRingPend  (OS_Q *p_q, rt_int32_t time, OS_MSG_SIZE *p_msg_size, CPU_TS *p_ts, OS_ERR *p_err);
+static  OS_OBJ_QTY   OS_QRingWake  (OS_Q *p_q);
+#endif
 
 /*
 ************************************************************************************************************************
@@ -90,7 +98,6 @@ OSQPendAbort
 *                              OS_ERR_OBJ_CREATED             if the message queue has already been created
 *                              OS_ERR_OBJ_PTR_NULL            if you passed a NULL pointer for 'p_q'
 *                              OS_ERR_Q_SIZE                  if the size you specified is 0
-*                            + OS_ERR_MEM_FULL                ڲڴѷ,ôʾ޷䵽ڴ
 *                          -------------˵-------------
 *                              OS_ERR_XXXX        ʾԼuCOS-IIIԭĴ
 *                            - OS_ERR_XXXX        ʾôڱݲѾ޷ʹ
@@ -107,10 +114,7 @@ void  OSQCreate (OS_Q        *p_q,
                  OS_ERR      *p_err)
 
 {
-    rt_err_t    rt_err;
-    rt_size_t 	msg_size;
-    rt_size_t 	pool_size;
-    rt_size_t   msg_header_size;
+    CPU_SR_ALLOC();
     
     /*Ƿж*/
     if(rt_interrupt_get_nest()!=0)
@@ -141,33 +145,165 @@ void  OSQCreate (OS_Q        *p_q,
     }
     
     /*жں˶ǷѾϢУǷѾ*/
-    if(rt_object_get_type(&p_q->rt_msg.parent.parent) == RT_Object_Class_MessageQueue)
+    if(rt_object_get_type(&p_q->Parent.parent) == RT_Object_Class_MessageQueue)
     {
         *p_err = OS_ERR_OBJ_CREATED;
         return;       
     }
     
-    /*RTTϢڲϢͷС,ڸýṹipc.cļڲûб¶,ֱдsizeof(rt_base_t)ָֽ*/
-    msg_header_size = sizeof(rt_base_t);/*sizeof(struct rt_mq_message)*/
+    rt_object_init(&(p_q->Parent.parent), RT_Object_Class_MessageQueue, (const char *)p_name);
+    p_q->Parent.parent.flag = RT_IPC_FLAG_PRIO;
+    rt_list_init(&(p_q->Parent.suspend_thread));/*ʹ,֤Ϸ*/
+    OS_PendListInit(&p_q->PendList);
+    OS_MsgQInit(&p_q->MsgQ, &OSMsgPool, max_qty);/*н¼󳤶,ϢͶʱŴȫϢȡ*/
+#if OS_CFG_Q_SPSC_EN > 0u
+    p_q->RingTbl     = RT_NULL;/*ͨϢ*/
+    p_q->RingInIx    = 0;
+    p_q->RingOutIx   = 0;
+    p_q->RingWaitPtr = RT_NULL;
+#endif
+    p_q->PostCtr     = 0;
+    p_q->PostFailCtr = 0;
+    p_q->PendCtr     = 0;
+    CPU_CRITICAL_ENTER();
+    rt_list_insert_after(&OSQList, &p_q->ListNode);/*ݲֻOSQListвOS_Q,OS_TaskChangePrio()*/
+    CPU_CRITICAL_EXIT();
+    
+    *p_err = OS_ERR_NONE;
+}
+
+/*
+************************************************************************************************************************
+*                                  CREATE A MESSAGE QUEUE WITH CALLER-SUPPLIED STORAGE
+*
+* Description: This function is called by your application to create a message queue whose OS_MSGs are taken from an
+*              array supplied by the caller instead of from the global message pool.
+*
+* Arguments  : p_q         is a pointer to the message queue
+*
+*              p_name      is a pointer to an ASCII string that will be used to name the message queue
+*
+*              p_msg_tbl   is a pointer to an array of 'max_qty' OS_MSGs that will hold the messages of this queue.
+*                          The array must remain valid until the queue is deleted, e.g.:
+*
+*                              static  OS_MSG  AppQMsgTbl[APP_Q_SIZE];
+*
+*              max_qty     indicates the maximum size of the message queue (must be non-zero) and the number of
+*                          entries in 'p_msg_tbl'.
+*
+*              p_err       is a pointer to a variable that will contain an error code returned by this function.
+*
+*                              OS_ERR_NONE                    the call was successful
+*                              OS_ERR_CREATE_ISR              can't create from an ISR
+*                              OS_ERR_MSG_POOL_NULL_PTR       if you passed a NULL pointer for 'p_msg_tbl'
+*                              OS_ERR_NAME                    if 'p_name' is a NULL pointer
+*                              OS_ERR_OBJ_CREATED             if the message queue has already been created
+*                              OS_ERR_OBJ_PTR_NULL            if you passed a NULL pointer for 'p_q'
+*                              OS_ERR_Q_SIZE                  if the size you specified is 0
+*
+* Returns    : none
+*
+* Note(s)    : 1) Ϊݲ,uCOS-IIIԭûиú.Ҫos_cfg.hнOS_CFG_Q_STATIC_ENΪ1
+*              2) 'p_msg_tbl'ΪOS_MSG,ɱ֤,Ϣʱ.bss,Ҫڴ
+*              3) Ϣжռ'p_msg_tbl',δʱͶݲΪռȫϢضʧ
+************************************************************************************************************************
+*/
+
+#if OS_CFG_Q_STATIC_EN > 0u
+void  OSQCreateStatic (OS_Q        *p_q,
+                       CPU_CHAR    *p_name,
+                       OS_MSG      *p_msg_tbl,
+                       OS_MSG_QTY   max_qty,
+                       OS_ERR      *p_err)
+{
+    /*Ϣ洢ռָǷΪNULL*/
+    if(p_msg_tbl == RT_NULL)
+    {
+        *p_err = OS_ERR_MSG_POOL_NULL_PTR;
+        return;
+    }
+    
+    OSQCreate(p_q, p_name, max_qty, p_err);/*Լں˶ĳʼOSQCreateͬ*/
+    if(*p_err != OS_ERR_NONE)
+    {
+        return;
+    }
+    
+    OS_MsgPoolCreate(&p_q->MsgPool, p_msg_tbl, max_qty);/*÷ṩĴ洢ռ֯Ϊ˽Ϣ*/
+    OS_MsgQInit(&p_q->MsgQ, &p_q->MsgPool, max_qty);
+}
+#endif
+
+/*
+************************************************************************************************************************
+*                              CREATE A LOCK-FREE SINGLE PRODUCER/SINGLE CONSUMER MESSAGE QUEUE
+*
+* Description: This function is called by your application to create a message queue that has exactly one producer
+*              (typically an ISR, e.g. a UART or ADC interrupt) and exactly one consumer task.  Posting to such a queue
+*              does not disable interrupts: the message is written into a ring and published by updating the ring's
+*              write index, and the consumer is only woken up when it is actually blocked on the queue.
+*
+* Arguments  : p_q         is a pointer to the message queue
+*
+*              p_name      is a pointer to an ASCII string that will be used to name the message queue
+*
+*              p_msg_tbl   is a pointer to an array of 'max_qty' OS_MSGs used as the ring.  The array must remain valid
+*                          until the queue is deleted, e.g.:
+*
+*                              static  OS_MSG  AppUartQTbl[APP_UART_Q_SIZE];
+*
+*              max_qty     indicates the maximum size of the message queue (1..32767) and the number of entries in
+*                          'p_msg_tbl'.
+*
+*              p_err       is a pointer to a variable that will contain an error code returned by this function.
+*
+*                              OS_ERR_NONE                    the call was successful
+*                              OS_ERR_CREATE_ISR              can't create from an ISR
+*                              OS_ERR_MSG_POOL_NULL_PTR       if you passed a NULL pointer for 'p_msg_tbl'
+*                              OS_ERR_NAME                    if 'p_name' is a NULL pointer
+*                              OS_ERR_OBJ_CREATED             if the message queue has already been created
+*                              OS_ERR_OBJ_PTR_NULL            if you passed a NULL pointer for 'p_q'
+*                              OS_ERR_Q_SIZE                  if the size you specified is 0 or larger than 32767
+*
+* Returns    : none
+*
+* Note(s)    : 1) Ϊݲ,uCOS-IIIԭûиú.Ҫos_cfg.hнOS_CFG_Q_SPSC_ENΪ1
+*              2) ֻһ(һжϻһ)OSQPost,ֻһOSQPend,ƻλ
+*              3) OSQPostֻ֧OS_OPT_POST_FIFO(ԼOS_OPT_POST_NO_SCHED),OS_OPT_POST_ALLû,ᱻ
+*              4) OS_CFG_ISR_POST_DEFERRED_ENӰ,жеͶֱ
+************************************************************************************************************************
+*/
+
+#if OS_CFG_Q_SPSC_EN > 0u
+void  OSQCreateSPSC (OS_Q        *p_q,
+                     CPU_CHAR    *p_name,
+                     OS_MSG      *p_msg_tbl,
+                     OS_MSG_QTY   max_qty,
+                     OS_ERR      *p_err)
+{
+    /*Ϣ洢ռָǷΪNULL*/
+    if(p_msg_tbl == RT_NULL)
+    {
+        *p_err = OS_ERR_MSG_POOL_NULL_PTR;
+        return;
+    }
     
-    msg_size = sizeof(ucos_msg_t);/*ϢһϢ󳤶ȣλֽ*/
-    pool_size = (msg_header_size+msg_size) * max_qty;/*ϢĻС*/
-    p_q->p_pool = RT_KERNEL_MALLOC(pool_size);/*ڴϢĻ*/
-    if(p_q->p_pool == RT_NULL)
+    /*дλõȡֵΧΪ[0,2*max_qty),ܳOS_MSG_QTYıʾΧ*/
+    if(max_qty > (OS_MSG_QTY)0x7FFFu)
     {
-        *p_err = OS_ERR_MEM_FULL;
+        *p_err = OS_ERR_Q_SIZE;
         return;
     }
     
-    rt_err = rt_mq_init(&p_q->rt_msg,
-                        (const char *)p_name,
-                         p_q->p_pool,
-                         msg_size,
-                         pool_size,
-                         RT_IPC_FLAG_FIFO);
+    OSQCreate(p_q, p_name, max_qty, p_err);/*Լں˶ĳʼOSQCreateͬ*/
+    if(*p_err != OS_ERR_NONE)
+    {
+        return;
+    }
     
-    *p_err = _err_rtt_to_ucosiii(rt_err);
+    p_q->RingTbl = p_msg_tbl;
 }
+#endif
 
 /*
 ************************************************************************************************************************
@@ -182,8 +318,6 @@ void  OSQCreate (OS_Q        *p_q,
 *                            OS_OPT_DEL_NO_PEND          Delete the queue ONLY if no task pending
 *                            OS_OPT_DEL_ALWAYS           Deletes the queue even if tasks are waiting.
 *                                                        In this case, all the tasks pending will be readied.
-*                            -------------˵-------------
-*                            RTTûʵOS_OPT_DEL_NO_PEND
 *
 *              p_err     is a pointer to a variable that will contain an error code returned by this function.
 *
@@ -192,7 +326,7 @@ void  OSQCreate (OS_Q        *p_q,
 *                            OS_ERR_OBJ_PTR_NULL         if you pass a NULL pointer for 'p_q'
 *                            OS_ERR_OBJ_TYPE             if the message queue was not created
 *                            OS_ERR_OPT_INVALID          An invalid option was specified
-*                          - OS_ERR_TASK_WAITING         One or more tasks were waiting on the queue
+*                            OS_ERR_TASK_WAITING         One or more tasks were waiting on the queue
 *                        -------------˵-------------
 *                            OS_ERR_XXXX        ʾԼuCOS-IIIԭĴ
 *                          - OS_ERR_XXXX        ʾôڱݲѾ޷ʹ
@@ -201,8 +335,6 @@ void  OSQCreate (OS_Q        *p_q,
 *
 * Returns    : == 0          if no tasks were waiting on the queue, or upon error.
 *              >  0          if one or more tasks waiting on the queue are now readied and informed.
-*              -------------˵-------------
-*              ֵ,RTTûʵֲ鿴ϢлмڵȴAPIֻܷ0
 *
 * Note(s)    : 1) This function must be used with care.  Tasks that would normally expect the presence of the queue MUST
 *                 check the return code of OSQPend().
@@ -218,7 +350,8 @@ OS_OBJ_QTY  OSQDel (OS_Q    *p_q,
                     OS_OPT   opt,
                     OS_ERR  *p_err)
 {
-    rt_err_t rt_err;
+    OS_OBJ_QTY  nbr_tasks;
+    CPU_SR_ALLOC();
     
     /*Ƿж*/
     if(rt_interrupt_get_nest()!=0)
@@ -235,25 +368,60 @@ OS_OBJ_QTY  OSQDel (OS_Q    *p_q,
     }
 
     /*жں˶ǷΪϢ*/
-    if(rt_object_get_type(&p_q->rt_msg.parent.parent) != RT_Object_Class_MessageQueue)
+    if(rt_object_get_type(&p_q->Parent.parent) != RT_Object_Class_MessageQueue)
     {
         *p_err = OS_ERR_OBJ_TYPE;
         return 0;       
     }
     
-    /*RTTûʵOS_OPT_DEL_NO_PEND*/
-    if(opt != OS_OPT_DEL_ALWAYS)
+    if(opt != OS_OPT_DEL_NO_PEND && opt != OS_OPT_DEL_ALWAYS)
     {
         *p_err = OS_ERR_OPT_INVALID;
-        RT_DEBUG_LOG(RT_DEBUG_UCOSIII,("OSQDel: wrapper can't accept this option\r\n"));
         return 0;
     }
     
-    rt_err = rt_mq_detach(&p_q->rt_msg);
-    RT_KERNEL_FREE(p_q->p_pool);/*ͷϢؿռ*/
+    CPU_CRITICAL_ENTER();
+#if OS_CFG_Q_SPSC_EN > 0u
+    if(p_q->RingTbl != RT_NULL)/*SPSCϢֻһڵȴ*/
+    {
+        if(opt == OS_OPT_DEL_NO_PEND && p_q->RingWaitPtr != RT_NULL)
+        {
+            CPU_CRITICAL_EXIT();
+            *p_err = OS_ERR_TASK_WAITING;
+            return 0;
+        }
+        rt_object_detach(&(p_q->Parent.parent));/*߱Ѻͨ͵֪Ϣѱɾ*/
+        rt_list_remove(&p_q->ListNode);
+        nbr_tasks = OS_QRingWake(p_q);
+        p_q->RingTbl = RT_NULL;
+        CPU_CRITICAL_EXIT();
+        if(nbr_tasks > 0)
+        {
+            OSSched();
+        }
+        *p_err = OS_ERR_NONE;
+        return nbr_tasks;
+    }
+#endif
+    if(opt == OS_OPT_DEL_NO_PEND && p_q->PendList.NbrEntries > 0)
+    {
+        CPU_CRITICAL_EXIT();
+        *p_err = OS_ERR_TASK_WAITING;
+        return 0;
+    }
+    nbr_tasks = OS_Post(&p_q->PendList, RT_NULL, 0, OS_STATUS_PEND_DEL, OS_TS_GET(), DEF_TRUE);/*еȴ*/
+    OS_MsgQFreeAll(&p_q->MsgQ);/*ʣϢ黹Ϣ*/
+    rt_object_detach(&(p_q->Parent.parent));
+    rt_list_remove(&p_q->ListNode);
+    CPU_CRITICAL_EXIT();
+    
+    if(nbr_tasks > 0)
+    {
+        OSSched();
+    }
     
-    *p_err = _err_rtt_to_ucosiii(rt_err);
-    return 0;/*ֵ,RTTûʵֲ鿴ϢлмڵȴAPIֻܷ0*/
+    *p_err = OS_ERR_NONE;
+    return nbr_tasks;
 }
 
 /*
@@ -277,6 +445,10 @@ OS_OBJ_QTY  OSQDel (OS_Q    *p_q,
 *                  references to what the queue entries are pointing to and thus, you could cause 'memory leaks'.  In
 *                  other words, the data you are pointing to that's being referenced by the queue entries should, most
 *                  likely, need to be de-allocated (i.e. freed).
+*
+*               2) ϢһԹ黹Ϣ,ִʱеϢ޹
+*
+*               3) OSQCreateSPSC()Ϣ,ֻ߿ƶλ,˱ñ
 ************************************************************************************************************************
 */
 
@@ -284,6 +456,52 @@ OS_OBJ_QTY  OSQDel (OS_Q    *p_q,
 OS_MSG_QTY  OSQFlush (OS_Q    *p_q,
                       OS_ERR  *p_err)
 {
+    OS_MSG_QTY  entries;
+#if OS_CFG_Q_SPSC_EN > 0u
+    CPU_INT32U  in;/*λλ32λ޷,OS_MSG_QTYΪint޷*/
+    CPU_INT32U  out;
+#endif
+    CPU_SR_ALLOC();
+    
+    /*Ƿж*/
+    if(rt_interrupt_get_nest()!=0)
+    {
+        *p_err = OS_ERR_FLUSH_ISR;
+        return 0;
+    }
+
+    /*ϢָǷΪNULL*/
+    if(p_q == RT_NULL)
+    {
+        *p_err = OS_ERR_OBJ_PTR_NULL;
+        return 0;
+    }
+
+    /*жں˶ǷΪϢ*/
+    if(rt_object_get_type(&p_q->Parent.parent) != RT_Object_Class_MessageQueue)
+    {
+        *p_err = OS_ERR_OBJ_TYPE;
+        return 0;
+    }
+    
+#if OS_CFG_Q_SPSC_EN > 0u
+    if(p_q->RingTbl != RT_NULL)/*λֱƵдλ*/
+    {
+        in  = p_q->RingInIx;
+        out = p_q->RingOutIx;
+        entries = (in >= out) ? (in - out) : (in + 2u * p_q->MsgQ.NbrEntriesSize - out);
+        p_q->RingOutIx = in;
+        *p_err = OS_ERR_NONE;
+        return entries;
+    }
+#endif
+    
+    CPU_CRITICAL_ENTER();
+    entries = OS_MsgQFreeAll(&p_q->MsgQ);
+    CPU_CRITICAL_EXIT();
+    
+    *p_err = OS_ERR_NONE;
+    return entries;
 }
 #endif
 
@@ -312,16 +530,17 @@ OS_MSG_QTY  OSQFlush (OS_Q    *p_q,
 *                            (CPU_TS *)0) then you will not get the timestamp.  In other words, passing a NULL pointer
 *                            is valid and indicates that you don't need the timestamp.
 *                            -------------˵-------------
-*                            òRTTû,NULL
+*                            ʱΪOS_TS_GET()ֵ(CPU),ʱOS_TS_GET()ΪͶݵյӳ
 *
 *              p_err         is a pointer to a variable that will contain an error code returned by this function.
 *
 *                                OS_ERR_NONE               The call was successful and your task received a message.
 *                                OS_ERR_OBJ_PTR_NULL       if you pass a NULL pointer for 'p_q'
 *                                OS_ERR_OBJ_TYPE           if the message queue was not created
-*                              - OS_ERR_PEND_ABORT         the pend was aborted
+*                                OS_ERR_OBJ_DEL            if 'p_q' was deleted
+*                                OS_ERR_PEND_ABORT         the pend was aborted
 *                                OS_ERR_PEND_ISR           if you called this function from an ISR
-*                              - OS_ERR_PEND_WOULD_BLOCK   If you specified non-blocking but the queue was not empty
+*                                OS_ERR_PEND_WOULD_BLOCK   If you specified non-blocking but the queue was not empty
 *                                OS_ERR_SCHED_LOCKED       the scheduler is locked
 *                                OS_ERR_TIMEOUT            A message was not received within the specified timeout
 *                                                          would lead to a suspension.
@@ -346,11 +565,15 @@ void  *OSQPend (OS_Q         *p_q,
                 CPU_TS       *p_ts,
                 OS_ERR       *p_err)
 {
-    rt_err_t    rt_err;
-    rt_int32_t  time;
-    ucos_msg_t  ucos_msg;
+    rt_int32_t    time;
+    void         *p_void;
+    OS_PEND_DATA  pend_data;
+    CPU_SR_ALLOC();
     
-    (void)p_ts;
+    if(p_ts != RT_NULL)
+    {
+        *p_ts = (CPU_TS)0;/*ʱʱʱΪ0*/
+    }
     
     /*Ƿж*/
     if(rt_interrupt_get_nest()!=0)
@@ -374,7 +597,7 @@ void  *OSQPend (OS_Q         *p_q,
     }    
     
     /*жں˶ǷΪϢ*/
-    if(rt_object_get_type(&p_q->rt_msg.parent.parent) != RT_Object_Class_MessageQueue)
+    if(rt_object_get_type(&p_q->Parent.parent) != RT_Object_Class_MessageQueue)
     {
         *p_err = OS_ERR_OBJ_TYPE;
         return 0;       
@@ -400,26 +623,278 @@ void  *OSQPend (OS_Q         *p_q,
     else
     {
         *p_err = OS_ERR_OPT_INVALID;/*optЧ*/
+        *p_msg_size = 0;
+        return RT_NULL;
     }
     
-    /*ʼϢԼ*/
-    rt_err = rt_mq_recv(&p_q->rt_msg,
-                        (void*)&ucos_msg,/*uCOSϢ*/
-                         sizeof(ucos_msg_t),/*uCOSϢγ*/
-                         time);
-
-    *p_err = _err_rtt_to_ucosiii(rt_err);
+#if OS_CFG_Q_SPSC_EN > 0u
+    if(p_q->RingTbl != RT_NULL)
+    {
+        return OS_QRingPend(p_q, time, p_msg_size, p_ts, p_err);
+    }
+#endif
+    
+    CPU_CRITICAL_ENTER();
+    p_void = OS_MsgQGet(&p_q->MsgQ, p_msg_size, p_ts, p_err);/*Ϣֱȡ*/
     if(*p_err == OS_ERR_NONE)
     {
-        *p_msg_size = ucos_msg.data_size;
-        return ucos_msg.data_ptr;
+        p_q->PendCtr++;
+        CPU_CRITICAL_EXIT();
+        return p_void;
     }
-    else
+    
+    if(time == 0)/*ΪҲ*/
     {
+        CPU_CRITICAL_EXIT();
+        *p_err = OS_ERR_PEND_WOULD_BLOCK;
         *p_msg_size = 0;
         return RT_NULL;
     }
+    
+    OS_Pend(p_q, &p_q->PendList, &pend_data, time, cpu_sr);/*ȴ,ʱѿж*/
+    
+    if(p_ts != RT_NULL)
+    {
+        *p_ts = pend_data.TS;
+    }
+    switch(pend_data.PendStatus)
+    {
+        case OS_STATUS_PEND_OK:
+            *p_msg_size = pend_data.MsgSize;
+            *p_err = OS_ERR_NONE;
+            return pend_data.MsgPtr;
+        
+        case OS_STATUS_PEND_TIMEOUT:
+            *p_err = OS_ERR_TIMEOUT;
+            break;
+        
+        case OS_STATUS_PEND_DEL:
+            *p_err = OS_ERR_OBJ_DEL;
+            break;
+        
+        case OS_STATUS_PEND_ABORT:
+        default:
+            *p_err = OS_ERR_PEND_ABORT;
+            break;
+    }
+    *p_msg_size = 0;
+    return RT_NULL;
+}
+
+/*
+************************************************************************************************************************
+*                                     PEND ON A QUEUE FOR ONE OR MORE MESSAGES
+*
+* Description: This function waits for at least one message to be sent to a queue and then retrieves, in a single
+*              critical section, as many of the messages that are already in the queue as will fit in the caller's
+*              tables.
+*
+* Arguments  : p_q           is a pointer to the message queue
+*
+*              timeout       is an optional timeout period (in clock ticks), same as OSQPend()
+*
+*              opt           determines whether the user wants to block if the queue is empty or not:
+*
+*                                OS_OPT_PEND_BLOCKING
+*                                OS_OPT_PEND_NON_BLOCKING
+*
+*              p_void_tbl    is a pointer to an array of 'nbr_max' entries that will receive the messages
+*
+*              p_size_tbl    is a pointer to an array of 'nbr_max' entries that will receive the size of each message.
+*                            You can pass a NULL pointer if you don't need the sizes.
+*
+*              nbr_max       is the maximum number of messages to retrieve
+*
+*              p_ts          is a pointer to a variable that will receive the timestamp of the first message received,
+*                            pend aborted or the message queue deleted.  You can pass a NULL pointer.
+*
+*              p_err         is a pointer to a variable that will contain an error code returned by this function.
+*
+*                                OS_ERR_NONE               At least one message was received
+*                                OS_ERR_OBJ_PTR_NULL       if you pass a NULL pointer for 'p_q'
+*                                OS_ERR_OBJ_TYPE           if the message queue was not created
+*                                OS_ERR_OBJ_DEL            if 'p_q' was deleted
+*                                OS_ERR_OPT_INVALID        if you specified an invalid option
+*                                OS_ERR_PEND_ABORT         the pend was aborted
+*                                OS_ERR_PEND_ISR           if you called this function from an ISR
+*                                OS_ERR_PEND_WOULD_BLOCK   If you specified non-blocking but the queue was empty
+*                                OS_ERR_PTR_INVALID        if 'p_void_tbl' is a NULL pointer or 'nbr_max' is 0
+*                                OS_ERR_SCHED_LOCKED       the scheduler is locked
+*                                OS_ERR_TIMEOUT            A message was not received within the specified timeout
+*
+* Returns    : The number of messages placed in 'p_void_tbl' (0 upon error)
+*
+* Note(s)    : 1) Ϊݲ,uCOS-IIIԭûиú.Ҫos_cfg.hнOS_CFG_Q_MULTI_ENΪ1
+*              2) ΪʱOSQPend()һ,ѵõһϢȡ߶еϢ,Ϊ
+*                 'nbr_max'Ϣȴ
+*              3) ͹жֻһ,'nbr_max'ԽжϵʱԽ
+************************************************************************************************************************
+*/
+
+#if OS_CFG_Q_MULTI_EN > 0u
+OS_MSG_QTY  OSQPendMulti (OS_Q          *p_q,
+                          OS_TICK        timeout,
+                          OS_OPT         opt,
+                          void         **p_void_tbl,
+                          OS_MSG_SIZE   *p_size_tbl,
+                          OS_MSG_QTY     nbr_max,
+                          CPU_TS        *p_ts,
+                          OS_ERR        *p_err)
+{
+    OS_PEND_DATA  pend_data;
+    OS_MSG_QTY    nbr;
+    OS_MSG_SIZE   msg_size;
+    OS_ERR        err;
+    rt_int32_t    time;
+    CPU_SR_ALLOC();
+    
+    if(p_ts != RT_NULL)
+    {
+        *p_ts = (CPU_TS)0;/*ʱʱʱΪ0*/
+    }
+    
+    /*Ƿж*/
+    if(rt_interrupt_get_nest()!=0)
+    {
+        *p_err = OS_ERR_PEND_ISR;
+        return 0;
+    }
+    
+    /*Ƿ*/
+    if(rt_critical_level() > 0)
+    {
+        *p_err = OS_ERR_SCHED_LOCKED;
+        return 0;
+    }
+    
+    /*ϢָǷΪNULL*/
+    if(p_q == RT_NULL)
+    {
+        *p_err = OS_ERR_OBJ_PTR_NULL;
+        return 0;
+    }
+    
+    /*Ϣ*/
+    if(p_void_tbl == RT_NULL || nbr_max == 0)
+    {
+        *p_err = OS_ERR_PTR_INVALID;
+        return 0;
+    }
+    
+    /*жں˶ǷΪϢ*/
+    if(rt_object_get_type(&p_q->Parent.parent) != RT_Object_Class_MessageQueue)
+    {
+        *p_err = OS_ERR_OBJ_TYPE;
+        return 0;
+    }
+    
+    /*RTTtimeoutΪ0ʾ,ΪRT_WAITING_FOREVERʾ,
+    uCOS-IIIͬ,Ҫת*/
+    if(opt == OS_OPT_PEND_BLOCKING)
+    {
+        if(timeout == 0)/*uCOS-IIItimeout=0ʾ*/
+        {
+            time = RT_WAITING_FOREVER;
+        }
+        else
+        {
+            time = timeout;
+        }
+    }
+    else if (opt == OS_OPT_PEND_NON_BLOCKING)
+    {
+        time = 0;/*RTTtimeoutΪ0ʾ*/
+    }
+    else
+    {
+        *p_err = OS_ERR_OPT_INVALID;/*optЧ*/
+        return 0;
+    }
+    
+#if OS_CFG_Q_SPSC_EN > 0u
+    if(p_q->RingTbl != RT_NULL)/*һϢĳʱȴ,Ϣȴ*/
+    {
+        for(nbr = 0; nbr < nbr_max; nbr++)
+        {
+            p_void_tbl[nbr] = OS_QRingPend(p_q, (nbr == 0) ? time : 0, &msg_size, (nbr == 0) ? p_ts : RT_NULL, &err);
+            if(err != OS_ERR_NONE)
+            {
+                break;
+            }
+            if(p_size_tbl != RT_NULL)
+            {
+                p_size_tbl[nbr] = msg_size;
+            }
+        }
+        *p_err = (nbr > 0) ? OS_ERR_NONE : err;
+        return nbr;
+    }
+#endif
+    
+    nbr = 0;
+    CPU_CRITICAL_ENTER();
+    if(p_q->MsgQ.NbrEntries == 0)/*Ϊ,ȵȴһϢ*/
+    {
+        if(time == 0)
+        {
+            CPU_CRITICAL_EXIT();
+            *p_err = OS_ERR_PEND_WOULD_BLOCK;
+            return 0;
+        }
+        
+        OS_Pend(p_q, &p_q->PendList, &pend_data, time, cpu_sr);/*ȴ,ʱѿж*/
+        
+        if(p_ts != RT_NULL)
+        {
+            *p_ts = pend_data.TS;
+        }
+        switch(pend_data.PendStatus)
+        {
+            case OS_STATUS_PEND_OK:
+                p_void_tbl[0] = pend_data.MsgPtr;
+                if(p_size_tbl != RT_NULL)
+                {
+                    p_size_tbl[0] = pend_data.MsgSize;
+                }
+                nbr = 1;
+                break;
+            
+            case OS_STATUS_PEND_TIMEOUT:
+                *p_err = OS_ERR_TIMEOUT;
+                return 0;
+            
+            case OS_STATUS_PEND_DEL:
+                *p_err = OS_ERR_OBJ_DEL;
+                return 0;
+            
+            case OS_STATUS_PEND_ABORT:
+            default:
+                *p_err = OS_ERR_PEND_ABORT;
+                return 0;
+        }
+        CPU_CRITICAL_ENTER();
+    }
+    
+    while(nbr < nbr_max)/*ȡ߶еϢ*/
+    {
+        p_void_tbl[nbr] = OS_MsgQGet(&p_q->MsgQ, &msg_size, (nbr == 0) ? p_ts : RT_NULL, &err);
+        if(err != OS_ERR_NONE)
+        {
+            break;
+        }
+        if(p_size_tbl != RT_NULL)
+        {
+            p_size_tbl[nbr] = msg_size;
+        }
+        p_q->PendCtr++;
+        nbr++;
+    }
+    CPU_CRITICAL_EXIT();
+    
+    *p_err = OS_ERR_NONE;
+    return nbr;
 }
+#endif
 
 /*
 ************************************************************************************************************************
@@ -449,6 +924,8 @@ void  *OSQPend (OS_Q         *p_q,
 *
 * Returns    : == 0          if no tasks were waiting on the queue, or upon error.
 *              >  0          if one or more tasks waiting on the queue are now readied and informed.
+*
+* Note(s)    : 1) ֹOSQPend()OS_ERR_PEND_ABORT
 ************************************************************************************************************************
 */
 
@@ -457,13 +934,78 @@ OS_OBJ_QTY  OSQPendAbort (OS_Q    *p_q,
                           OS_OPT   opt,
                           OS_ERR  *p_err)
 {
-}
+    OS_OBJ_QTY   nbr_tasks;
+#if OS_CFG_Q_SPSC_EN > 0u
+    rt_thread_t  thread;
 #endif
-
-/*
-************************************************************************************************************************
-*                                               POST MESSAGE TO A QUEUE
-*
+    CPU_SR_ALLOC();
+    
+    /*Ƿж*/
+    if(rt_interrupt_get_nest()!=0)
+    {
+        *p_err = OS_ERR_PEND_ABORT_ISR;
+        return 0;
+    }
+
+    /*ϢָǷΪNULL*/
+    if(p_q == RT_NULL)
+    {
+        *p_err = OS_ERR_OBJ_PTR_NULL;
+        return 0;
+    }
+
+    /*жں˶ǷΪϢ*/
+    if(rt_object_get_type(&p_q->Parent.parent) != RT_Object_Class_MessageQueue)
+    {
+        *p_err = OS_ERR_OBJ_TYPE;
+        return 0;
+    }
+    
+    if((opt & ~(OS_OPT_PEND_ABORT_ALL|OS_OPT_POST_NO_SCHED)) != 0)
+    {
+        *p_err = OS_ERR_OPT_INVALID;
+        return 0;
+    }
+    
+    CPU_CRITICAL_ENTER();
+#if OS_CFG_Q_SPSC_EN > 0u
+    if(p_q->RingTbl != RT_NULL)/*SPSCϢֻһڵȴ*/
+    {
+        thread = p_q->RingWaitPtr;
+        if(thread != RT_NULL && (thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_SUSPEND)
+        {
+            thread->error = -RT_ERROR;/*߾ݴ˵֪ȴֹ*/
+        }
+        nbr_tasks = OS_QRingWake(p_q);
+    }
+    else
+#endif
+    {
+        nbr_tasks = OS_Post(&p_q->PendList, RT_NULL, 0, OS_STATUS_PEND_ABORT, OS_TS_GET(),
+                            (opt & OS_OPT_PEND_ABORT_ALL) ? DEF_TRUE : DEF_FALSE);
+    }
+    CPU_CRITICAL_EXIT();
+    
+    if(nbr_tasks == 0)
+    {
+        *p_err = OS_ERR_PEND_ABORT_NONE;
+        return 0;
+    }
+    
+    if((opt & OS_OPT_POST_NO_SCHED) == 0)
+    {
+        OSSched();
+    }
+    
+    *p_err = OS_ERR_NONE;
+    return nbr_tasks;
+}
+#endif
+
+/*
+************************************************************************************************************************
+*                                               POST MESSAGE TO A QUEUE
+*
 * Description: This function sends a message to a queue.  With the 'opt' argument, you can specify whether the message
 *              is broadcast to all waiting tasks and/or whether you post the message to the front of the queue (LIFO)
 *              or normally (FIFO) at the end of the queue.
@@ -476,13 +1018,13 @@ OS_OBJ_QTY  OSQPendAbort (OS_Q    *p_q,
 *
 *              opt           determines the type of POST performed:
 *
-*                              - OS_OPT_POST_ALL          POST to ALL tasks that are waiting on the queue.  This option
+*                                OS_OPT_POST_ALL          POST to ALL tasks that are waiting on the queue.  This option
 *                                                         can be added to either OS_OPT_POST_FIFO or OS_OPT_POST_LIFO
 *                                OS_OPT_POST_FIFO         POST message to end of queue (FIFO) and wake up a single
 *                                                         waiting task.
 *                                OS_OPT_POST_LIFO         POST message to the front of the queue (LIFO) and wake up
 *                                                         a single waiting task.
-*                              - OS_OPT_POST_NO_SCHED     Do not call the scheduler
+*                                OS_OPT_POST_NO_SCHED     Do not call the scheduler
 *
 *                            Note(s): 1) OS_OPT_POST_NO_SCHED can be added (or OR'd) with one of the other options.
 *                                     2) OS_OPT_POST_ALL      can be added (or OR'd) with one of the other options.
@@ -497,15 +1039,17 @@ OS_OBJ_QTY  OSQPendAbort (OS_Q    *p_q,
 *                                        OS_OPT_POST_FIFO + OS_OPT_POST_ALL + OS_OPT_POST_NO_SCHED
 *                                        OS_OPT_POST_LIFO + OS_OPT_POST_ALL + OS_OPT_POST_NO_SCHED
 *                       -------------˵-------------
-*                        RTTûʵй,optѡֻΪOS_OPT_POST_FIFOOS_OPT_POST_LIFO
+*                        OS_OPT_POST_ALL:ͬһϢһιжнȫȴ,ֻ֮һ
+*                        OS_OPT_POST_NO_SCHED:ֻȴ,֮OSSched()򲻴ѡͶͳһ
 *
 *              p_err         is a pointer to a variable that will contain an error code returned by this function.
 *
 *                                OS_ERR_NONE            The call was successful and the message was sent
-*                              - OS_ERR_MSG_POOL_EMPTY  If there are no more OS_MSGs to use to place the message into
+*                                OS_ERR_MSG_POOL_EMPTY  If there are no more OS_MSGs to use to place the message into
 *                                OS_ERR_OBJ_PTR_NULL    If 'p_q' is a NULL pointer
 *                                OS_ERR_OBJ_TYPE        If the message queue was not initialized
 *                                OS_ERR_Q_MAX           If the queue is full
+*                                OS_ERR_INT_Q_FULL      If the post was deferred but the ISR queue is full (ӳٷʱ)
 8                              + OS_ERR_OPT_INVALID     You specified an invalid option
 *                            -------------˵-------------
 *                                OS_ERR_XXXX        ʾԼuCOS-IIIԭĴ
@@ -523,8 +1067,10 @@ void  OSQPost (OS_Q         *p_q,
                OS_OPT        opt,
                OS_ERR       *p_err)
 {
-    rt_err_t rt_err;
-    ucos_msg_t  ucos_msg;
+    CPU_TS  ts;
+    CPU_SR_ALLOC();
+    
+    ts = OS_TS_GET();/*Ͷݵʱ,Ϣһ𽻸շ*/
     
     /*ϢָǷΪNULL*/
     if(p_q == RT_NULL)
@@ -534,29 +1080,550 @@ void  OSQPost (OS_Q         *p_q,
     }
     
     /*жں˶ǷΪϢ*/
-    if(rt_object_get_type(&p_q->rt_msg.parent.parent) != RT_Object_Class_MessageQueue)
+    if(rt_object_get_type(&p_q->Parent.parent) != RT_Object_Class_MessageQueue)
     {
         *p_err = OS_ERR_OBJ_TYPE;
         return;       
     }
     
-    /*װuCOSϢ*/
-    ucos_msg.data_size = msg_size;
-    ucos_msg.data_ptr = p_void;
+    if((opt & ~(OS_OPT_POST_LIFO | OS_OPT_POST_ALL | OS_OPT_POST_NO_SCHED)) != 0)
+    {
+        *p_err = OS_ERR_OPT_INVALID;
+        RT_DEBUG_LOG(RT_DEBUG_UCOSIII,("OSQPost: wrapper can't accept this option\r\n"));
+        return;
+    }
     
-    if(opt == OS_OPT_POST_FIFO)
+#if OS_CFG_Q_SPSC_EN > 0u
+    if(p_q->RingTbl != RT_NULL)/*SPSCϢеͶݲж,жҲֱͶ*/
     {
-        rt_err = rt_mq_send(&p_q->rt_msg,(void*)&ucos_msg,sizeof(ucos_msg_t));
+        OS_QRingPost(p_q, p_void, msg_size, opt, ts, p_err);
+        return;
     }
-    else if(opt == OS_OPT_POST_LIFO)
+#endif
+    
+#if OS_CFG_ISR_POST_DEFERRED_EN > 0u
+    if(rt_interrupt_get_nest()!=0)/*жֻдж϶,ж϶дͶ*/
     {
-        rt_err = rt_mq_urgent(&p_q->rt_msg,(void*)&ucos_msg,sizeof(ucos_msg_t));
+        OS_IntQPost((OS_OBJ_TYPE)RT_Object_Class_MessageQueue, (void *)p_q, p_void, msg_size, 0, opt, p_err);
+        return;
+    }
+#endif
+    
+    CPU_CRITICAL_ENTER();
+    if(p_q->PendList.NbrEntries > 0)/*ڵȴ,ֱӽϢȼߵĵȴ(ȫȴ)*/
+    {
+        p_q->PendCtr += OS_Post(&p_q->PendList, p_void, msg_size, OS_STATUS_PEND_OK, ts,
+                                (opt & OS_OPT_POST_ALL) ? DEF_TRUE : DEF_FALSE);
+        p_q->PostCtr++;
+        CPU_CRITICAL_EXIT();
+        if((opt & OS_OPT_POST_NO_SCHED) == 0)
+        {
+            OSSched();
+        }
+        *p_err = OS_ERR_NONE;
+        return;
+    }
+    
+    OS_MsgQPut(&p_q->MsgQ, p_void, msg_size, opt, ts, p_err);/*ϢȡһOS_MSGҵ*/
+    if(*p_err == OS_ERR_NONE)
+    {
+        p_q->PostCtr++;
     }
     else
+    {
+        p_q->PostFailCtr++;
+    }
+    CPU_CRITICAL_EXIT();
+}
+
+/*
+************************************************************************************************************************
+*                                          POST MULTIPLE MESSAGES TO A QUEUE
+*
+* Description: This function sends up to 'nbr' messages to a queue in a single critical section.  Each message is handed
+*              to the highest priority task waiting on the queue, if any, or else placed in the queue.
+*
+* Arguments  : p_q           is a pointer to a message queue that must have been created by OSQCreate().
+*
+*              p_void_tbl    is a pointer to an array of 'nbr' messages to send
+*
+*              p_size_tbl    is a pointer to an array of 'nbr' message sizes (in bytes).  You can pass a NULL pointer,
+*                            in which case all the messages are sent with a size of 0.
+*
+*              nbr           is the number of messages to send
+*
+*              opt           determines the type of POST performed:
+*
+*                                OS_OPT_POST_FIFO         POST messages to end of queue (FIFO)
+*                                OS_OPT_POST_LIFO         POST messages to the front of the queue (LIFO)
+*                                OS_OPT_POST_NO_SCHED     Do not call the scheduler
+*
+*              p_err         is a pointer to a variable that will contain an error code returned by this function.
+*
+*                                OS_ERR_NONE            All the messages were sent
+*                                OS_ERR_MSG_POOL_EMPTY  If there are no more OS_MSGs to use to place a message into
+*                                OS_ERR_OBJ_PTR_NULL    If 'p_q' is a NULL pointer
+*                                OS_ERR_OBJ_TYPE        If the message queue was not initialized
+*                                OS_ERR_OPT_INVALID     if you specified an invalid option
+*                                OS_ERR_PTR_INVALID     If 'p_void_tbl' is a NULL pointer
+*                                OS_ERR_Q_MAX           If the queue became full
+*                                OS_ERR_INT_Q_FULL      If the post was deferred but the ISR queue is full (ӳٷʱ)
+*
+* Returns    : The number of messages actually sent.  When an error is reported, the messages from this index onward
+*              were not sent.
+*
+* Note(s)    : 1) Ϊݲ,uCOS-IIIԭûиú.Ҫos_cfg.hнOS_CFG_Q_MULTI_ENΪ1
+*              2) OS_OPT_POST_LIFOʱ嵽ͷ,һϢȱȡ
+*              3) ֧OS_OPT_POST_ALL;ϢͶɺһ
+*              4) ͹жֻһ,'nbr'ԽжϵʱԽ
+************************************************************************************************************************
+*/
+
+#if OS_CFG_Q_MULTI_EN > 0u
+OS_MSG_QTY  OSQPostMulti (OS_Q          *p_q,
+                          void         **p_void_tbl,
+                          OS_MSG_SIZE   *p_size_tbl,
+                          OS_MSG_QTY     nbr,
+                          OS_OPT         opt,
+                          OS_ERR        *p_err)
+{
+    OS_MSG_QTY   i;
+    OS_MSG_SIZE  msg_size;
+    OS_OBJ_QTY   nbr_tasks;
+    CPU_TS       ts;
+    CPU_SR_ALLOC();
+    
+    ts = OS_TS_GET();/*ͬһϢʹͬһͶʱ*/
+    
+    /*ϢָǷΪNULL*/
+    if(p_q == RT_NULL)
+    {
+        *p_err = OS_ERR_OBJ_PTR_NULL;
+        return 0;
+    }
+    
+    /*Ϣ*/
+    if(p_void_tbl == RT_NULL)
+    {
+        *p_err = OS_ERR_PTR_INVALID;
+        return 0;
+    }
+    
+    /*жں˶ǷΪϢ*/
+    if(rt_object_get_type(&p_q->Parent.parent) != RT_Object_Class_MessageQueue)
+    {
+        *p_err = OS_ERR_OBJ_TYPE;
+        return 0;
+    }
+    
+    if((opt & ~(OS_OPT_POST_LIFO | OS_OPT_POST_NO_SCHED)) != 0)
     {
         *p_err = OS_ERR_OPT_INVALID;
-        RT_DEBUG_LOG(RT_DEBUG_UCOSIII,("OSQPost: wrapper can't accept this option\r\n"));
+        return 0;
+    }
+    
+    *p_err = OS_ERR_NONE;
+    
+#if OS_CFG_Q_SPSC_EN > 0u
+    if(p_q->RingTbl != RT_NULL)/*д뻷λ,ͳһ*/
+    {
+        for(i = 0; i < nbr; i++)
+        {
+            msg_size = (p_size_tbl != RT_NULL) ? p_size_tbl[i] : 0;
+            OS_QRingPost(p_q, p_void_tbl[i], msg_size, opt | OS_OPT_POST_NO_SCHED, ts, p_err);
+            if(*p_err != OS_ERR_NONE)
+            {
+                break;
+            }
+        }
+        if(i > 0 && (opt & OS_OPT_POST_NO_SCHED) == 0)
+        {
+            OSSched();
+        }
+        return i;
+    }
+#endif
+    
+#if OS_CFG_ISR_POST_DEFERRED_EN > 0u
+    if(rt_interrupt_get_nest()!=0)/*жֻдж϶,ж϶дͶ*/
+    {
+        for(i = 0; i < nbr; i++)
+        {
+            msg_size = (p_size_tbl != RT_NULL) ? p_size_tbl[i] : 0;
+            OS_IntQPost((OS_OBJ_TYPE)RT_Object_Class_MessageQueue, (void *)p_q, p_void_tbl[i], msg_size, 0, opt, p_err);
+            if(*p_err != OS_ERR_NONE)
+            {
+                break;
+            }
+        }
+        return i;
+    }
+#endif
+    
+    nbr_tasks = 0;
+    CPU_CRITICAL_ENTER();
+    for(i = 0; i < nbr; i++)
+    {
+        msg_size = (p_size_tbl != RT_NULL) ? p_size_tbl[i] : 0;
+        if(p_q->PendList.NbrEntries > 0)/*ڵȴ,ֱӽϢȼߵĵȴ*/
+        {
+            nbr_tasks += OS_Post(&p_q->PendList, p_void_tbl[i], msg_size, OS_STATUS_PEND_OK, ts, DEF_FALSE);
+            p_q->PendCtr++;
+        }
+        else
+        {
+            OS_MsgQPut(&p_q->MsgQ, p_void_tbl[i], msg_size, opt, ts, p_err);
+            if(*p_err != OS_ERR_NONE)
+            {
+                p_q->PostFailCtr++;
+                break;
+            }
+        }
+    }
+    p_q->PostCtr += i;
+    CPU_CRITICAL_EXIT();
+    
+    if(nbr_tasks > 0 && (opt & OS_OPT_POST_NO_SCHED) == 0)
+    {
+        OSSched();
+    }
+    return i;
+}
+#endif
+
+/*
+************************************************************************************************************************
+*                                            RESET MESSAGE QUEUE STATISTICS
+*
+* Description: This function restarts the statistics that are kept for a message queue.  The statistics are always
+*              maintained and can be read directly from the OS_Q:
+*
+*                  p_q->MsgQ.NbrEntries       current number of messages in the queue
+*                  p_q->MsgQ.NbrEntriesMax    peak number of messages in the queue
+*                  p_q->MsgQ.NbrEntriesSize   maximum number of messages in the queue ('max_qty')
+*                  p_q->PostCtr               number of messages posted
+*                  p_q->PostFailCtr           number of posts that failed because the queue was full (or the message
+*                                             pool was empty)
+*                  p_q->PendCtr               number of messages received by tasks
+*
+* Arguments  : p_q       is a pointer to the message queue
+*
+*              p_err     is a pointer to a variable that will contain an error code returned by this function.
+*
+*                            OS_ERR_NONE            The statistics were reset
+*                            OS_ERR_OBJ_PTR_NULL    If 'p_q' is a NULL pointer
+*                            OS_ERR_OBJ_TYPE        If the message queue was not created
+*
+* Returns    : none
+*
+* Note(s)    : 1) Ϊݲ,uCOS-IIIԭûиú
+*              2) NbrEntriesMaxΪеǰϢ,,֮¹۲һʱڵķֵ,
+*                 ݴ˵ʱ'max_qty'ԼOS_CFG_MSG_POOL_SIZE
+*              3) OSQCreateSPSC()ϢвάMsgQ.NbrEntries,ǰϢRingInIxRingOutIx֮ó;
+*                 ͳݲж޸,/ڼÿܶʧһμ
+************************************************************************************************************************
+*/
+
+void  OSQStatReset (OS_Q    *p_q,
+                    OS_ERR  *p_err)
+{
+#if OS_CFG_Q_SPSC_EN > 0u
+    CPU_INT32U  in;
+    CPU_INT32U  out;
+#endif
+    CPU_SR_ALLOC();
+    
+    /*ϢָǷΪNULL*/
+    if(p_q == RT_NULL)
+    {
+        *p_err = OS_ERR_OBJ_PTR_NULL;
+        return;
+    }
+    
+    /*жں˶ǷΪϢ*/
+    if(rt_object_get_type(&p_q->Parent.parent) != RT_Object_Class_MessageQueue)
+    {
+        *p_err = OS_ERR_OBJ_TYPE;
         return;
     }
-    *p_err = _err_rtt_to_ucosiii(rt_err); 
+    
+    CPU_CRITICAL_ENTER();
+#if OS_CFG_Q_SPSC_EN > 0u
+    if(p_q->RingTbl != RT_NULL)
+    {
+        in  = p_q->RingInIx;
+        out = p_q->RingOutIx;
+        p_q->MsgQ.NbrEntriesMax = (in >= out) ? (in - out) : (in + 2u * p_q->MsgQ.NbrEntriesSize - out);
+    }
+    else
+#endif
+    {
+        p_q->MsgQ.NbrEntriesMax = p_q->MsgQ.NbrEntries;
+    }
+    p_q->PostCtr     = 0;
+    p_q->PostFailCtr = 0;
+    p_q->PendCtr     = 0;
+    CPU_CRITICAL_EXIT();
+    
+    *p_err = OS_ERR_NONE;
 }
+
+#if OS_CFG_Q_SPSC_EN > 0u
+/*
+************************************************************************************************************************
+*                                        POST TO A SINGLE PRODUCER/SINGLE CONSUMER QUEUE
+*
+* Description: This function writes a message into the ring of an SPSC message queue without disabling interrupts.
+*
+* Arguments  : p_q           is a pointer to a message queue created by OSQCreateSPSC()
+*
+*              p_void        is a pointer to the message to send
+*
+*              msg_size      specifies the size of the message (in bytes)
+*
+*              opt           OS_OPT_POST_FIFO, optionally with OS_OPT_POST_NO_SCHED
+*
+*              ts            is the timestamp of the post
+*
+*              p_err         is a pointer to a variable that will contain an error code returned by this function.
+*
+*                                OS_ERR_NONE            The call was successful and the message was sent
+*                                OS_ERR_Q_MAX           If the queue is full
+*                                OS_ERR_OPT_INVALID     OS_OPT_POST_LIFO is not supported
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) дλ,ͨCPU_MB()֤λдλö߿ɼ;дλúٴCPU_MB(),
+*                 ֤߼дλ߼RingWaitPtrͬʱԷ
+*              3) ֻʱŹжϻ,жϵʱΪ
+************************************************************************************************************************
+*/
+
+static  void  OS_QRingPost (OS_Q         *p_q,
+                            void         *p_void,
+                            OS_MSG_SIZE   msg_size,
+                            OS_OPT        opt,
+                            CPU_TS        ts,
+                            OS_ERR       *p_err)
+{
+    CPU_INT32U   size;
+    CPU_INT32U   in;
+    CPU_INT32U   out;
+    CPU_INT32U   nbr;
+    OS_MSG      *p_msg;
+    OS_OBJ_QTY   nbr_tasks;
+    CPU_SR_ALLOC();
+
+
+    if((opt & OS_OPT_POST_LIFO) != 0)
+    {
+        *p_err = OS_ERR_OPT_INVALID;
+        return;
+    }
+
+    size = p_q->MsgQ.NbrEntriesSize;
+    in   = p_q->RingInIx;
+    out  = p_q->RingOutIx;
+    nbr  = (in >= out) ? (in - out) : (in + 2u * size - out);
+    if(nbr >= size)/**/
+    {
+        p_q->PostFailCtr++;
+        *p_err = OS_ERR_Q_MAX;
+        return;
+    }
+
+    p_msg = &p_q->RingTbl[(in < size) ? in : (in - size)];
+    p_msg->MsgPtr  = p_void;
+    p_msg->MsgSize = msg_size;
+    p_msg->MsgTS   = ts;
+    CPU_MB();/*λݱдλö߿ɼ*/
+
+    in++;
+    p_q->RingInIx = (in == 2u * size) ? 0u : in;
+    CPU_MB();/*дλñڼǷ*/
+
+    p_q->PostCtr++;/*ͳֻ޸*/
+    if(p_q->MsgQ.NbrEntriesMax <= nbr)
+    {
+        p_q->MsgQ.NbrEntriesMax = nbr + 1u;
+    }
+
+    if(p_q->RingWaitPtr != RT_NULL)/*ֻʱҪ*/
+    {
+        CPU_CRITICAL_ENTER();
+        nbr_tasks = OS_QRingWake(p_q);
+        CPU_CRITICAL_EXIT();
+        if(nbr_tasks > 0 && (opt & OS_OPT_POST_NO_SCHED) == 0)
+        {
+            OSSched();
+        }
+    }
+    *p_err = OS_ERR_NONE;
+}
+
+/*
+************************************************************************************************************************
+*                                       PEND ON A SINGLE PRODUCER/SINGLE CONSUMER QUEUE
+*
+* Description: This function reads a message from the ring of an SPSC message queue, blocking the (single) consumer if
+*              the ring is empty.
+*
+* Arguments  : p_q           is a pointer to a message queue created by OSQCreateSPSC()
+*
+*              time          RTTĳʱʱ:0ʾ,RT_WAITING_FOREVERʾõȴ,0ʾȴtick
+*
+*              p_msg_size    is a pointer to a variable that will receive the size of the message
+*
+*              p_ts          is a pointer to a variable that will receive the timestamp of the message (may be NULL)
+*
+*              p_err         is a pointer to a variable that will contain an error code returned by this function.
+*
+*                                OS_ERR_NONE               The call was successful and your task received a message.
+*                                OS_ERR_OBJ_DEL            if 'p_q' was deleted
+*                                OS_ERR_PEND_ABORT         the pend was aborted
+*                                OS_ERR_PEND_WOULD_BLOCK   If you specified non-blocking but the queue was empty
+*                                OS_ERR_TIMEOUT            A message was not received within the specified timeout
+*
+* Returns    : a pointer to the message received or NULL
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) ȡϢĻλʱж;ֻ׼ʱŹж,ڹжϵ״̬µǼRingWaitPtrٴ
+*                 дλ,ӶڴڼдϢ
+************************************************************************************************************************
+*/
+
+static  void  *OS_QRingPend (OS_Q         *p_q,
+                             rt_int32_t    time,
+                             OS_MSG_SIZE  *p_msg_size,
+                             CPU_TS       *p_ts,
+                             OS_ERR       *p_err)
+{
+    CPU_INT32U    size;
+    CPU_INT32U    out;
+    OS_MSG       *p_msg;
+    void         *p_void;
+    rt_thread_t   thread;
+    OS_TCB       *p_tcb;
+    rt_bool_t     timed_out;
+    CPU_SR_ALLOC();
+
+
+    thread    = rt_thread_self();
+    p_tcb     = OS_TCB_GET(thread);
+    size      = p_q->MsgQ.NbrEntriesSize;
+    timed_out = RT_FALSE;
+    while(1)
+    {
+        out = p_q->RingOutIx;
+        if(out != p_q->RingInIx)/*λϢ*/
+        {
+            CPU_MB();/*дλ֮ܶȡλ*/
+            p_msg       = &p_q->RingTbl[(out < size) ? out : (out - size)];
+            p_void      = p_msg->MsgPtr;
+            *p_msg_size = p_msg->MsgSize;
+            if(p_ts != RT_NULL)
+            {
+                *p_ts = p_msg->MsgTS;
+            }
+            CPU_MB();/*λݶ֮ܽ黹*/
+            out++;
+            p_q->RingOutIx = (out == 2u * size) ? 0u : out;
+            p_q->PendCtr++;/*ֻ޸*/
+            *p_err = OS_ERR_NONE;
+            return p_void;
+        }
+
+        *p_msg_size = 0;
+        if(time == 0)/*ΪҲ*/
+        {
+            *p_err = OS_ERR_PEND_WOULD_BLOCK;
+            return RT_NULL;
+        }
+        if(timed_out == RT_TRUE)
+        {
+            *p_err = OS_ERR_TIMEOUT;
+            return RT_NULL;
+        }
+
+        CPU_CRITICAL_ENTER();
+        if(p_q->RingInIx != out)/*׼ڼдϢ*/
+        {
+            CPU_CRITICAL_EXIT();
+            continue;
+        }
+        p_q->RingWaitPtr = thread;
+        if(p_tcb != RT_NULL)
+        {
+            p_tcb->PendObjPtr = p_q;/*OS_TaskPendDel()*/
+        }
+        thread->error = RT_EOK;
+        rt_thread_suspend(thread);
+        if(time > 0)/*̶߳ʱгʱʱ*/
+        {
+            rt_timer_control(&(thread->thread_timer), RT_TIMER_CTRL_SET_TIME, &time);
+            rt_timer_start(&(thread->thread_timer));
+        }
+        CPU_CRITICAL_EXIT();
+
+        rt_schedule();
+
+        CPU_CRITICAL_ENTER();
+        p_q->RingWaitPtr = RT_NULL;
+        if(p_tcb != RT_NULL)
+        {
+            p_tcb->PendObjPtr = RT_NULL;
+        }
+        CPU_CRITICAL_EXIT();
+
+        if(rt_object_get_type(&p_q->Parent.parent) != RT_Object_Class_MessageQueue)
+        {
+            *p_err = OS_ERR_OBJ_DEL;
+            return RT_NULL;
+        }
+        if(thread->error == -RT_ETIMEOUT)
+        {
+            timed_out = RT_TRUE;/*ټһλλ,Ϊ򷵻سʱ*/
+        }
+        else if(thread->error != RT_EOK)
+        {
+            *p_err = OS_ERR_PEND_ABORT;
+            return RT_NULL;
+        }
+    }
+}
+
+/*
+************************************************************************************************************************
+*                                     WAKE UP THE CONSUMER OF A SINGLE PRODUCER/SINGLE CONSUMER QUEUE
+*
+* Description: This function readies the consumer of an SPSC message queue if it is blocked on the queue.
+*
+* Arguments  : p_q           is a pointer to a message queue created by OSQCreateSPSC()
+*
+* Returns    : the number of tasks made ready to run (0 or 1)
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) ڹжϵ״̬µ,ᴥ
+************************************************************************************************************************
+*/
+
+static  OS_OBJ_QTY  OS_QRingWake (OS_Q  *p_q)
+{
+    rt_thread_t  thread;
+
+
+    thread = p_q->RingWaitPtr;
+    if(thread == RT_NULL)
+    {
+        return 0;
+    }
+    p_q->RingWaitPtr = RT_NULL;
+    if((thread->stat & RT_THREAD_STAT_MASK) != RT_THREAD_SUSPEND)/*Ѿʱ*/
+    {
+        return 0;
+    }
+    rt_thread_resume(thread);
+    return 1;
+}
+#endif
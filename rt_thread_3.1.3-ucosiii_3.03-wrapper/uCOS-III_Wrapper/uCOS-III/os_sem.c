@@ -51,7 +51,10 @@
         OS_OPT_POST_1 (൱RT_IPC_FLAG_PRIO)
         OS_OPT_POST_ALL (RT-Threadδʵ)
         OS_OPT_POST_NO_SCHED (RT-Threadδʵ)
-    ֻʵRT_IPC_FLAG_PRIOOS_OPT_POST_1Ϊźļ
+    ˲RT_IPC_FLAG_PRIOOS_OPT_POST_1Ϊźļ
+    źͷɼݲʵ(rt_sem_release),֧:
+        OS_OPT_POST_ALL:һιжоźϵȫȴ,ֻ֮һ
+        OS_OPT_POST_NO_SCHED:ֻȴ,֮OSSched()򲻴ѡͶͳһ
 */
 
 /*
@@ -125,13 +128,14 @@ void  OSSemCreate (OS_SEM      *p_sem,
     }
     
     /*жں˶ǷѾźǷѾ*/
-    if(rt_object_get_type(&p_sem->parent.parent) == RT_Object_Class_Semaphore)
+    if(rt_object_get_type(&p_sem->Sem.parent.parent) == RT_Object_Class_Semaphore)
     {
         *p_err = OS_ERR_OBJ_CREATED;
         return;       
     }    
     
-    rt_err = rt_sem_init(p_sem,(const char*)p_name,cnt,RT_IPC_FLAG_PRIO);
+    rt_err = rt_sem_init(&p_sem->Sem,(const char*)p_name,cnt,RT_IPC_FLAG_PRIO);
+    p_sem->TS = (CPU_TS)0;
     
     *p_err = _err_rtt_to_ucosiii(rt_err); 
 }
@@ -201,7 +205,7 @@ OS_OBJ_QTY  OSSemDel (OS_SEM  *p_sem,
     }  
 
     /*жں˶ǷΪź*/
-    if(rt_object_get_type(&p_sem->parent.parent) != RT_Object_Class_Semaphore)
+    if(rt_object_get_type(&p_sem->Sem.parent.parent) != RT_Object_Class_Semaphore)
     {
         *p_err = OS_ERR_OBJ_TYPE;
         return 0;       
@@ -215,7 +219,7 @@ OS_OBJ_QTY  OSSemDel (OS_SEM  *p_sem,
         return 0;
     }
     
-    rt_err = rt_sem_detach(p_sem);
+    rt_err = rt_sem_detach(&p_sem->Sem);
     *p_err = _err_rtt_to_ucosiii(rt_err); 
     return 0;/*ֵ,RTTûʵֲ鿴źмڵȴAPIֻܷ0*/
 }
@@ -243,7 +247,8 @@ OS_OBJ_QTY  OSSemDel (OS_SEM  *p_sem,
 *                            then you will not get the timestamp.  In other words, passing a NULL pointer is valid
 *                            and indicates that you don't need the timestamp.
 *                            -------------˵-------------
-*                            òRTTû,NULL
+*                            źʱźһαͶݵʱ(OS_TS_GET()ֵ),ȴ֮ǰź
+*                            ֱͶ,õǺһͶݵʱ;ʱʱΪ0
 *               
 *              p_err         is a pointer to a variable that will contain an error code returned by this function.
 *
@@ -281,8 +286,12 @@ OS_SEM_CTR  OSSemPend (OS_SEM   *p_sem,
 {  
     rt_err_t rt_err;
     rt_int32_t time;
+    OS_TCB *p_tcb;
     
-    (void)p_ts;
+    if(p_ts != RT_NULL)
+    {
+        *p_ts = (CPU_TS)0;/*ʱʱʱΪ0*/
+    }
     
     /*Ƿж*/
     if(rt_interrupt_get_nest()!=0)
@@ -306,7 +315,7 @@ OS_SEM_CTR  OSSemPend (OS_SEM   *p_sem,
     }  
     
     /*жں˶ǷΪź*/
-    if(rt_object_get_type(&p_sem->parent.parent) != RT_Object_Class_Semaphore)
+    if(rt_object_get_type(&p_sem->Sem.parent.parent) != RT_Object_Class_Semaphore)
     {
         *p_err = OS_ERR_OBJ_TYPE;
         return 0;       
@@ -334,10 +343,23 @@ OS_SEM_CTR  OSSemPend (OS_SEM   *p_sem,
         *p_err = OS_ERR_OPT_INVALID;/*optЧ*/
     }
     
-    rt_err = rt_sem_take(p_sem,time);
+    p_tcb = OS_TCB_GET(rt_thread_self());
+    if(p_tcb != RT_NULL)
+    {
+        p_tcb->PendObjPtr = &p_sem->Sem;/*ȴڼ䱻޸ȼʱֻźĵȴб,OS_TaskChangePrio()*/
+    }
+    rt_err = rt_sem_take(&p_sem->Sem,time);
+    if(p_tcb != RT_NULL)
+    {
+        p_tcb->PendObjPtr = RT_NULL;
+    }
+    if(rt_err == RT_EOK && p_ts != RT_NULL)
+    {
+        *p_ts = p_sem->TS;
+    }
     
     *p_err = _err_rtt_to_ucosiii(rt_err); 
-    return p_sem->value;/*źʣvalue*/
+    return p_sem->Sem.value;/*źʣvalue*/
 }
 
 /*
@@ -396,20 +418,21 @@ OS_OBJ_QTY  OSSemPendAbort (OS_SEM  *p_sem,
 *
 *                           OS_OPT_POST_1            POST and ready only the highest priority task waiting on semaphore
 *                                                    (if tasks are waiting).
-*                         - OS_OPT_POST_ALL          POST to ALL tasks that are waiting on the semaphore
+*                           OS_OPT_POST_ALL          POST to ALL tasks that are waiting on the semaphore
 *
-*                         - OS_OPT_POST_NO_SCHED     Do not call the scheduler
+*                           OS_OPT_POST_NO_SCHED     Do not call the scheduler
 *
 *                           Note(s): 1) OS_OPT_POST_NO_SCHED can be added with one of the other options.
 *                       -------------˵-------------
-*                        RTTûʵй,optѡֻΪOS_OPT_POST_1
+*                        OS_OPT_POST_ALL:ڵȴ,ȫźֵ;ûڵȴ,ֵ1
 *
 *              p_err    is a pointer to a variable that will contain an error code returned by this function.
 *
 *                           OS_ERR_NONE          The call was successful and the semaphore was signaled.
 *                           OS_ERR_OBJ_PTR_NULL  If 'p_sem' is a NULL pointer.
 *                           OS_ERR_OBJ_TYPE      If 'p_sem' is not pointing at a semaphore
-*                         - OS_ERR_SEM_OVF       If the post would cause the semaphore count to overflow.
+*                           OS_ERR_SEM_OVF       If the post would cause the semaphore count to overflow.
+*                           OS_ERR_INT_Q_FULL    If the post was deferred but the ISR queue is full (ӳٷʱ)
 *                         + OS_ERR_OPT_INVALID   ԭһoptЧĴ
 *                       -------------˵-------------
 *                           OS_ERR_XXXX        ʾԼuCOS-IIIԭĴ
@@ -422,10 +445,14 @@ OS_OBJ_QTY  OSSemPendAbort (OS_SEM  *p_sem,
 */
 
 OS_SEM_CTR  OSSemPost (OS_SEM  *p_sem,
-                       OS_OPT   opt,/*optѡΪOS_OPT_POST_1*/
+                       OS_OPT   opt,
                        OS_ERR  *p_err)
 {
-    rt_err_t rt_err;
+    rt_thread_t  thread;
+    CPU_TS       ts;
+    CPU_SR_ALLOC();
+    
+    ts = OS_TS_GET();/*Ͷݵʱ*/
     
     /*ָǷΪ*/
     if(p_sem == RT_NULL)
@@ -435,24 +462,61 @@ OS_SEM_CTR  OSSemPost (OS_SEM  *p_sem,
     }  
     
     /*жں˶ǷΪź*/
-    if(rt_object_get_type(&p_sem->parent.parent) != RT_Object_Class_Semaphore)
+    if(rt_object_get_type(&p_sem->Sem.parent.parent) != RT_Object_Class_Semaphore)
     {
         *p_err = OS_ERR_OBJ_TYPE;
         return 0;       
     }
     
-    /*optѡֻΪOS_OPT_POST_1*/
-    if(opt != OS_OPT_POST_1)
+    /*optѡֻΪOS_OPT_POST_1OS_OPT_POST_ALL,ټOS_OPT_POST_NO_SCHED*/
+    if((opt & ~(OS_OPT_POST_ALL | OS_OPT_POST_NO_SCHED)) != 0)
     {
         *p_err = OS_ERR_OPT_INVALID;
         RT_DEBUG_LOG(RT_DEBUG_UCOSIII,("OSSemPost: wrapper can't accept this option\r\n"));
         return 0;
     }
     
-    rt_err = rt_sem_release(p_sem);
+#if OS_CFG_ISR_POST_DEFERRED_EN > 0u
+    if(rt_interrupt_get_nest()!=0)/*жֻдж϶,ж϶дͶ*/
+    {
+        OS_IntQPost((OS_OBJ_TYPE)RT_Object_Class_Semaphore, (void *)p_sem, (void *)0, 0, 0, opt, p_err);
+        return 0;
+    }
+#endif
     
-    *p_err = _err_rtt_to_ucosiii(rt_err); 
-    return p_sem->value;/*źʣvalue*/
+    CPU_CRITICAL_ENTER();
+    if(rt_list_isempty(&(p_sem->Sem.parent.suspend_thread)))/*ûڵȴ,ֵ1*/
+    {
+        if(p_sem->Sem.value == (OS_SEM_CTR)0xFFFFu)/*RTTźļֵΪ16λ*/
+        {
+            CPU_CRITICAL_EXIT();
+            *p_err = OS_ERR_SEM_OVF;
+            return 0;
+        }
+        p_sem->Sem.value++;
+        p_sem->TS = ts;
+        CPU_CRITICAL_EXIT();
+        *p_err = OS_ERR_NONE;
+        return p_sem->Sem.value;
+    }
+    
+    /*ڵȴ,źֱӽȴ,ֵ*/
+    p_sem->TS = ts;
+    do
+    {
+        thread = rt_list_entry(p_sem->Sem.parent.suspend_thread.next, struct rt_thread, tlist);
+        thread->error = RT_EOK;
+        rt_thread_resume(thread);/*ֻ,ὫӹƳ*/
+    }while((opt & OS_OPT_POST_ALL) && !rt_list_isempty(&(p_sem->Sem.parent.suspend_thread)));
+    CPU_CRITICAL_EXIT();
+    
+    if((opt & OS_OPT_POST_NO_SCHED) == 0)
+    {
+        OSSched();/*ֻһ*/
+    }
+    
+    *p_err = OS_ERR_NONE;
+    return p_sem->Sem.value;/*źʣvalue*/
 }
 
 /*
@@ -43,9 +43,35 @@
 #include <os.h>
 
 /*
-RTTûͳ񣬱ļкʵ
+RTTûͳ񣬼ݲдһͳ(OS_StatTask):
+    1)ϵͳCPUʹ:ӶOSStatTaskCtr,ͳÿ1/OS_CFG_STAT_TASK_RATE_HZȡһ,
+      OSStatTaskCPUUsageInit()궨мOSStatTaskCtrMaxȽϵõOSStatTaskCPUUsage
+    2)CPUʹ:OS_CFG_TASK_PROFILE_EN(ֻͳOSTaskCreate())
 */
 
+#if OS_CFG_STAT_TASK_EN > 0u
+
+#ifndef RT_USING_IDLE_HOOK
+#error "OS_CFG_STAT_TASK_ENҪrtconfig.hпRT_USING_IDLE_HOOK"
+#endif
+#ifdef BSP_USING_TICKLESS_IDLE
+#error "OS_CFG_STAT_TASK_ENBSP_USING_TICKLESS_IDLEͬʱʹ(˯ʱмֹͣ)"
+#endif
+#if (OS_CFG_STAT_TASK_RATE_HZ == 0u) || (OS_CFG_STAT_TASK_RATE_HZ > RT_TICK_PER_SECOND)
+#error "OS_CFG_STAT_TASK_RATE_HZ1~RT_TICK_PER_SECOND֮"
+#endif
+
+OS_CPU_USAGE   OSStatTaskCPUUsage;                          /* CPU Usage in %                                         */
+OS_CPU_USAGE   OSStatTaskCPUUsageMax;                       /* CPU Usage in % (Peak)                                  */
+OS_TICK        OSStatTaskCtr;                               /* Idle counter, incremented by the idle task hook        */
+OS_TICK        OSStatTaskCtrMax;                            /* Idle counter value during one period with no load      */
+OS_TICK        OSStatTaskCtrRun;                            /* Idle counter value of the last period                  */
+CPU_BOOLEAN    OSStatTaskRdy;                               /* Flag indicating that the statistic task is ready       */
+
+ALIGN(RT_ALIGN_SIZE)
+static  rt_uint8_t        OSCfg_StatTaskStk[OS_CFG_STAT_TASK_STK_SIZE];
+static  struct rt_thread  OSStatTaskTCB;                    /* ͳ                                               */
+
 /*
 ************************************************************************************************************************
 *                                                   RESET STATISTICS
@@ -55,13 +81,70 @@
 * Argument(s): p_err      is a pointer to a variable that will contain an error code returned by this function.
 *
 *                             OS_ERR_NONE
+*                           - OS_ERR_STAT_RESET_ISR     if you called this function from an ISR
 *
 * Returns    : none
+*
+* Note(s)    : 1) ϵͳ͸CPUʹʵķֵ,ԼϢءж϶СϢеķֵͳ
 ************************************************************************************************************************
 */
 
 void  OSStatReset (OS_ERR  *p_err)
 {
+#if (OS_CFG_TASK_PROFILE_EN > 0u) || (OS_CFG_TASK_Q_EN > 0u)
+    struct rt_object_information *info;
+    struct rt_list_node          *p_node;
+    OS_TCB                       *p_tcb;
+#endif
+    CPU_SR_ALLOC();
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if(p_err == (OS_ERR *)0)
+    {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return;
+    }
+#endif
+
+    if(rt_interrupt_get_nest()!=0)                          /* Can't be called from an ISR                            */
+    {
+       *p_err = OS_ERR_STAT_RESET_ISR;
+        return;
+    }
+
+    CPU_CRITICAL_ENTER();
+    OSStatTaskCPUUsageMax = 0u;
+    OSMsgPool.NbrUsedMax  = OSMsgPool.NbrUsed;
+#if OS_CFG_ISR_POST_DEFERRED_EN > 0u
+    OSIntQNbrEntriesMax   = (OS_OBJ_QTY)0u;
+    OSIntQOvfCtr          = (OS_OBJ_QTY)0u;
+#endif
+    CPU_CRITICAL_EXIT();
+
+#if (OS_CFG_TASK_PROFILE_EN > 0u) || (OS_CFG_TASK_Q_EN > 0u)
+    info = rt_object_get_information(RT_Object_Class_Thread);
+    rt_enter_critical();                                    /* ڼ䲻ɾ                                 */
+    for(p_node = info->object_list.next; p_node != &info->object_list; p_node = p_node->next)
+    {
+        p_tcb = OS_TCB_GET((rt_thread_t)rt_list_entry(p_node, struct rt_object, list));
+        if(p_tcb == RT_NULL)
+        {
+            continue;
+        }
+        CPU_CRITICAL_ENTER();
+#if OS_CFG_TASK_PROFILE_EN > 0u
+        p_tcb->CPUUsageMax = 0u;
+#endif
+#if OS_CFG_TASK_Q_EN > 0u
+        p_tcb->MsgQ.NbrEntriesMax = p_tcb->MsgQ.NbrEntries;
+#endif
+        CPU_CRITICAL_EXIT();
+    }
+    rt_exit_critical();
+#endif
+
+   *p_err = OS_ERR_NONE;
 }
 
 /*
@@ -80,11 +163,245 @@ void  OSStatReset (OS_ERR  *p_err)
 * Argument(s): p_err      is a pointer to a variable that will contain an error code returned by this function.
 *
 *                             OS_ERR_NONE
+*                           - OS_ERR_STAT_RESET_ISR     if you called this function from an ISR
 *
 * Returns    : none
+*
+* Note(s)    : 1) 궨ʱΪһͳ(1/OS_CFG_STAT_TASK_RATE_HZ),ڼ䱾ʱ״̬,
+*                 ӦӦ񴴽֮ǰɵһӦ(main),ʹ궨ʱֻп
+*              2) ͳڱ궨(OSStatTaskRdyΪDEF_TRUE)֮ſʼ,궨ڼֻбдOSStatTaskCtr;
+*                 ٴεñʱͳͣдOSStatTaskCtr,ֱ±궨
 ************************************************************************************************************************
 */
 
 void  OSStatTaskCPUUsageInit (OS_ERR  *p_err)
 {
+    CPU_SR_ALLOC();
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if(p_err == (OS_ERR *)0)
+    {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return;
+    }
+#endif
+
+    if(rt_interrupt_get_nest()!=0)                          /* Can't be called from an ISR                            */
+    {
+       *p_err = OS_ERR_STAT_RESET_ISR;
+        return;
+    }
+
+    CPU_CRITICAL_ENTER();
+    OSStatTaskRdy    = DEF_FALSE;                           /* 궨ڼͳм                     */
+    CPU_CRITICAL_EXIT();
+
+    rt_thread_delay(2u);                                    /* Synchronize with clock tick                            */
+    CPU_CRITICAL_ENTER();
+    OSStatTaskCtr    = (OS_TICK)0u;                         /* Clear idle counter                                     */
+    CPU_CRITICAL_EXIT();
+
+    rt_thread_delay(RT_TICK_PER_SECOND / OS_CFG_STAT_TASK_RATE_HZ);/* Determine MAX. idle counter value for 1 period  */
+
+    CPU_CRITICAL_ENTER();
+    OSStatTaskCtrMax = OSStatTaskCtr;                       /* Store maximum idle counter count                       */
+    OSStatTaskCtr    = (OS_TICK)0u;
+    OSStatTaskRdy    = DEF_TRUE;
+    CPU_CRITICAL_EXIT();
+   *p_err            = OS_ERR_NONE;
+}
+
+/*
+************************************************************************************************************************
+*                                                   IDLE TASK HOOK
+*
+* Description: This function is installed by OS_StatTaskInit() as an RT-Thread idle hook.  It counts how many times the
+*              idle task loops so that the statistic task can derive the CPU usage.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+************************************************************************************************************************
+*/
+
+static  void  OS_StatIdleHook (void)
+{
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();
+    OSStatTaskCtr++;
+    CPU_CRITICAL_EXIT();
+}
+
+/*
+************************************************************************************************************************
+*                                                    STATISTICS TASK
+*
+* Description: This task is created by OSInit() and computes the total CPU usage and the CPU usage of every task
+*              created by OSTaskCreate().
+*
+* Arguments  : p_arg    is a pointer to an optional argument that is passed during task creation.  For this function
+*                       the argument is not used and will be a NULL pointer.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) ÿ1/OS_CFG_STAT_TASK_RATE_HZִһ,ϵͳCPUʹ = 10000 - 10000 * OSStatTaskCtrRun / OSStatTaskCtrMax
+*              3) CPUʹԱDWT߹Ϊĸ,ۼƵ(CyclesDelta)Ϊ;
+*                 гʱۼ,е(ͳԼ)ͳƷΧ,˲©
+*              4) ʹʾΪ0~10000,Ӧ0.00%~100.00%
+*              5) OSStatTaskCPUUsageInit()궨֮ǰֻȴ,дOSStatTaskCtr
+*              6) ʱֻ:ֻл޸,ڼ䲻л,жԱֿ
+************************************************************************************************************************
+*/
+
+static  void  OS_StatTask (void  *p_arg)
+{
+#if OS_CFG_TASK_PROFILE_EN > 0u
+    struct rt_object_information *info;
+    struct rt_list_node          *p_node;
+    OS_TCB                       *p_tcb;
+    CPU_TS_TMR                    ts_prev;
+    CPU_TS_TMR                    ts_now;
+    OS_CYCLES                     window;
+#endif
+    OS_CPU_USAGE                  usage;
+    CPU_SR_ALLOC();
+
+
+    (void)p_arg;
+    while(OSStatTaskRdy != DEF_TRUE)                        /* Wait until the idle counter has been calibrated        */
+    {
+        rt_thread_delay(2u * RT_TICK_PER_SECOND / OS_CFG_STAT_TASK_RATE_HZ);
+    }
+    CPU_CRITICAL_ENTER();
+    OSStatTaskCtr = (OS_TICK)0u;                            /* һͳڴӴ˿̿ʼ                               */
+    CPU_CRITICAL_EXIT();
+#if OS_CFG_TASK_PROFILE_EN > 0u
+    info    = rt_object_get_information(RT_Object_Class_Thread);
+    ts_prev = CPU_TS_TmrRd();
+#endif
+    while(DEF_ON)
+    {
+        rt_thread_delay(RT_TICK_PER_SECOND / OS_CFG_STAT_TASK_RATE_HZ);
+
+        CPU_CRITICAL_ENTER();
+        if(OSStatTaskRdy != DEF_TRUE)                       /* ±궨,мOSStatTaskCPUUsageInit()ʹ  */
+        {
+            CPU_CRITICAL_EXIT();
+            continue;
+        }
+        OSStatTaskCtrRun = OSStatTaskCtr;                   /* Obtain the idle counter of the past period            */
+        OSStatTaskCtr    = (OS_TICK)0u;                     /* Reset the idle counter for the next period             */
+        CPU_CRITICAL_EXIT();
+
+        if(OSStatTaskCtrMax > (OS_TICK)0u)
+        {
+            if(OSStatTaskCtrRun >= OSStatTaskCtrMax)        /* ȱ궨ʱ(궨ʱ)               */
+            {
+                usage = 0u;
+            }
+            else
+            {
+                usage = (OS_CPU_USAGE)(10000u - ((CPU_INT64U)OSStatTaskCtrRun * 10000u) / OSStatTaskCtrMax);
+            }
+            OSStatTaskCPUUsage = usage;
+            if(OSStatTaskCPUUsageMax < usage)
+            {
+                OSStatTaskCPUUsageMax = usage;
+            }
+        }
+
+#if OS_CFG_TASK_PROFILE_EN > 0u
+        rt_enter_critical();                                /* ,Note(s) 6                                   */
+        ts_now  = CPU_TS_TmrRd();
+        window  = (OS_CYCLES)(ts_now - ts_prev);
+        ts_prev = ts_now;
+        if(window == (OS_CYCLES)0u)
+        {
+            window = (OS_CYCLES)1u;
+        }
+        for(p_node = info->object_list.next; p_node != &info->object_list; p_node = p_node->next)
+        {
+            p_tcb = OS_TCB_GET((rt_thread_t)rt_list_entry(p_node, struct rt_object, list));
+            if(p_tcb == RT_NULL)                            /* OSTaskCreate()                           */
+            {
+                continue;
+            }
+            p_tcb->CyclesDelta     = p_tcb->CyclesTotal - p_tcb->CyclesTotalPrev;
+            p_tcb->CyclesTotalPrev = p_tcb->CyclesTotal;
+            p_tcb->CPUUsage        = (OS_CPU_USAGE)(((CPU_INT64U)p_tcb->CyclesDelta * 10000u) / window);
+            if(p_tcb->CPUUsage > 10000u)
+            {
+                p_tcb->CPUUsage = 10000u;
+            }
+            if(p_tcb->CPUUsageMax < p_tcb->CPUUsage)
+            {
+                p_tcb->CPUUsageMax = p_tcb->CPUUsage;
+            }
+        }
+        rt_exit_critical();
+#endif
+    }
 }
+
+/*
+************************************************************************************************************************
+*                                              INITIALIZE THE STATISTICS TASK
+*
+* Description: This function is called by OSInit() to create the statistics task.
+*
+* Arguments  : p_err    is a pointer to a variable that will contain an error code returned by this function.
+*
+*                           OS_ERR_NONE              the statistics task was created
+*                           OS_ERR_STAT_PRIO_INVALID if OS_CFG_STAT_TASK_PRIO is not a valid RT-Thread priority
+*                         + OS_ERR_RT_ERROR
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+************************************************************************************************************************
+*/
+
+void  OS_StatTaskInit (OS_ERR  *p_err)
+{
+    rt_err_t  rt_err;
+    
+    
+    if(OS_CFG_STAT_TASK_PRIO >= RT_THREAD_PRIORITY_MAX - 1u)   /* ͬ                         */
+    {
+       *p_err = OS_ERR_STAT_PRIO_INVALID;
+        return;
+    }
+
+    OSStatTaskCPUUsage    = 0u;
+    OSStatTaskCPUUsageMax = 0u;
+    OSStatTaskCtr         = (OS_TICK)0u;
+    OSStatTaskCtrMax      = (OS_TICK)0u;
+    OSStatTaskCtrRun      = (OS_TICK)0u;
+    OSStatTaskRdy         = DEF_FALSE;                      /* Statistic task is not ready until calibrated           */
+
+    rt_thread_idle_sethook(OS_StatIdleHook);
+
+    rt_err = rt_thread_init(&OSStatTaskTCB,
+                            "os_stat",
+                            OS_StatTask,
+                            RT_NULL,
+                            &OSCfg_StatTaskStk[0],
+                            sizeof(OSCfg_StatTaskStk),
+                            OS_CFG_STAT_TASK_PRIO,
+                            1u);
+    if(rt_err != RT_EOK)
+    {
+       *p_err = _err_rtt_to_ucosiii(rt_err);
+        return;
+    }
+    rt_thread_startup(&OSStatTaskTCB);
+   *p_err = OS_ERR_NONE;
+}
+
+#endif
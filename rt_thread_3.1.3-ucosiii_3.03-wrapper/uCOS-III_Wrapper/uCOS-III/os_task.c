@@ -43,26 +43,22 @@
 #include <os.h>
 
 /*
-RTTûؽӿڣºûʵ
-1)ڽźϢ
-OSTaskQFlush
-OSTaskQPend
-OSTaskQPendAbort
-OSTaskQPost
-OSTaskSemPend
-OSTaskSemPendAbort
-OSTaskSemPost
-OSTaskSemSet
-
-2)ڽĴ
-OSTaskRegGet
-OSTaskRegSet
-
-3)й޸
-OSTaskChangePrio
-OSTaskTimeQuantaSet
+OS_TCB˵:
+    OS_TCBRTT߳̿ƿĻչuCOS-IIIеĳԱ,һԱΪstruct rt_thread,
+    ˿ֱΪrt_thread_tRTTĽӿ;ֻOSTaskCreate()žЩչԱ
+    ڽϢ:ϢȡȫϢ,󳤶ΪOSTaskCreate()q_size;ͶݷֱͨOS_TCBҵ,
+    ûں˶ͼ,ҲҪȴб
+    ڽź:ֵOS_TCB,ͶֻǼֵ1,ڵȴʱֱӾһ
+    Ĵ:OS_CFG_TASK_REG_TBL_SIZEOS_REGOS_TCB,IDֱӶд;OSTaskCreate()p_extExtPtr
 */
 
+#if OS_CFG_TASK_REG_TBL_SIZE > 0u
+OS_REG_ID  OSTaskRegNextAvailID;                            /* Next available Task Register ID                        */
+#endif
+
+static  rt_uint32_t  OS_TaskStkUsedMax (rt_thread_t  thread);
+static  void         OS_TaskEntry      (void        *p_arg);
+
 /*
 ************************************************************************************************************************
 *                                                CHANGE PRIORITY OF A TASK
@@ -78,9 +74,19 @@ OSTaskTimeQuantaSet
 *
 *                             OS_ERR_NONE                 is the call was successful
 *                             OS_ERR_PRIO_INVALID         if the priority you specify is higher that the maximum allowed
-*                                                         (i.e. >= (OS_CFG_PRIO_MAX-1))
+*                                                         (i.e. >= (OS_CFG_PRIO_MAX-1)) or, if OS_CFG_ISR_POST_DEFERRED_EN
+*                                                         is set to 1 and you tried to use priority 0 which is reserved.
 *                             OS_ERR_STATE_INVALID        if the task is in an invalid state
 *                             OS_ERR_TASK_CHANGE_PRIO_ISR if you tried to change the task's priority from an ISR
+*
+* Returns    : none
+*
+* Note(s)    : 1) p_tcbΪNULLʱʾ޸ĵǰȼ
+*              2) prio_newΪĻȼ(init_priority),ͬʱделoriginal_priority,
+*                 ͷŻʱָľµȼ.ȼ̳ж,ȼprio_new,
+*                 ͷŻ֮ǰԱȼ
+*              3) ھб͵ȴбеλûᰴµȼ;ڵȴ,ȼڻ
+*                 ,߻̳иȼ
 ************************************************************************************************************************
 */
 
@@ -88,6 +94,84 @@ void  OSTaskChangePrio (OS_TCB   *p_tcb,
                         OS_PRIO   prio_new,
                         OS_ERR   *p_err)
 {
+    rt_thread_t                    thread;
+    struct rt_object_information  *p_info;
+    rt_list_t                     *p_node;
+    rt_mutex_t                     p_mutex;
+    rt_thread_t                    thread_pend;
+    OS_PRIO                        prio_cur;
+    CPU_SR_ALLOC();
+    
+    /*Ƿж*/
+    if(rt_interrupt_get_nest()!=0)
+    {
+        *p_err = OS_ERR_TASK_CHANGE_PRIO_ISR;
+        return;
+    }
+    
+    /*ȼ,ȼ*/
+    if(prio_new >= RT_THREAD_PRIORITY_MAX-1)
+    {
+        *p_err = OS_ERR_PRIO_INVALID;
+        return;
+    }
+    
+#if OS_CFG_ISR_POST_DEFERRED_EN > 0u
+    /*ȼ0ж϶д*/
+    if(prio_new == 0)
+    {
+        *p_err = OS_ERR_PRIO_INVALID;
+        return;
+    }
+#endif
+    
+    /*TCBָΪNULL,ʾ޸ĵǰ*/
+    if(p_tcb == RT_NULL)
+    {
+        p_tcb = (OS_TCB *)rt_thread_self();
+    }
+    thread = &p_tcb->Task;
+    
+    CPU_CRITICAL_ENTER();
+    /*δѾ*/
+    if((thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_INIT ||
+       (thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_CLOSE)
+    {
+        CPU_CRITICAL_EXIT();
+        *p_err = OS_ERR_STATE_INVALID;
+        return;
+    }
+    
+    thread->init_priority = prio_new;
+    prio_cur = prio_new;
+    
+    /*¸еĻ,ҳȼ̳Ӧֵȼ*/
+    p_info = rt_object_get_information(RT_Object_Class_Mutex);
+    for(p_node  = p_info->object_list.next;
+        p_node != &p_info->object_list;
+        p_node  = p_node->next)
+    {
+        p_mutex = (rt_mutex_t)rt_list_entry(p_node, struct rt_object, list);
+        if(p_mutex->owner != thread)
+        {
+            continue;
+        }
+        p_mutex->original_priority = prio_new;
+        if(!rt_list_isempty(&(p_mutex->parent.suspend_thread)))
+        {
+            thread_pend = rt_list_entry(p_mutex->parent.suspend_thread.next, struct rt_thread, tlist);
+            if(thread_pend->current_priority < prio_cur)
+            {
+                prio_cur = thread_pend->current_priority;
+            }
+        }
+    }
+    
+    OS_TaskChangePrio(thread, prio_cur);/*б/ȴб,ȴʱȼ̳*/
+    CPU_CRITICAL_EXIT();
+    
+    OSSched();/*͵ǰȼ,Ҫл*/
+    *p_err = OS_ERR_NONE;
 }
 
 /*
@@ -124,7 +208,8 @@ void  OSTaskChangePrio (OS_TCB   *p_tcb,
 *                             specifying 10% of the 'stk_size' value indicates that the stack limit will be reached
 *                             when the stack reaches 90% full.
 *                            -------------˵-------------
-*                             òڱݲû壬ʲô
+*                             OS_CFG_TASK_STK_LIMIT_ENΪ1ʱ,ÿл񶼻䱣SPǷԽþλ,
+*                             ԽOS_AppStkLimitHookPtr.Ϊ0ʾֻڶջջײʱŵ
 *
 *              stk_size       is the size of the stack in number of elements.  If CPU_STK is set to CPU_INT08U,
 *                             'stk_size' corresponds to the number of bytes available.  If CPU_STK is set to
@@ -134,17 +219,19 @@ void  OSTaskChangePrio (OS_TCB   *p_tcb,
 *
 *              q_size         is the maximum number of messages that can be sent to the task
 *                            -------------˵-------------
-*                             òڱݲû壬ʲô
+*                             ڽϢе󳤶,ϢȡȫϢ,洢ռ
 *
 *              time_quanta    amount of time (in ticks) for time slice when round-robin between tasks.  Specify 0 to use
 *                             the default.
+*                            -------------˵-------------
+*                             Ϊ0ʱʹOSSchedRoundRobinCfg()õĬϳ;ʱƬתֹʱòݲЧ
 *
 *              p_ext          is a pointer to a user supplied memory location which is used as a TCB extension.
 *                             For example, this user memory can hold the contents of floating-point registers
 *                             during a context switch, the time each task takes to execute, the number of times
 *                             the task has been switched-in, etc.
 *                            -------------˵-------------
-*                             òڱݲû壬ʲô
+*                             OS_TCBExtPtr,ݲ㱾ʹ
 *
 *              opt            contains additional information (or options) about the behavior of the task.
 *                             See OS_OPT_TASK_xxx in OS.H.  Current choices are:
@@ -158,7 +245,7 @@ void  OSTaskChangePrio (OS_TCB   *p_tcb,
 *                                                             Storage) support for the task.  If you do not include this
 *                                                             option, TLS will be supported by default.
 *                            -------------˵-------------
-*                             òڱݲû壬ʲô
+*                             ĿǰֻOS_OPT_TASK_NO_TLS:ָʱӶջײOS_TLS_STK_SIZECPU_STKΪTLS۱
 *
 *
 *              p_err          is a pointer to an error code that will be set during this call.  The value pointer
@@ -174,8 +261,10 @@ void  OSTaskChangePrio (OS_TCB   *p_tcb,
 *                                                                   to use priority 0 which is reserved.
 *                                 OS_ERR_STK_INVALID             if you specified a NULL pointer for 'p_stk_base'
 *                                 OS_ERR_STK_SIZE_INVALID        if you specified zero for the 'stk_size'
-*                               - OS_ERR_STK_LIMIT_INVALID       if you specified a 'stk_limit' greater than or equal
+*                                                                   (߶ջŲTLS۱)
+*                                 OS_ERR_STK_LIMIT_INVALID       if you specified a 'stk_limit' greater than or equal
 *                                                                   to 'stk_size'
+*                                                                   (TLS۱ռõĲֲ'stk_size')
 *                                 OS_ERR_TASK_CREATE_ISR         if you tried to create a task from an ISR.
 *                                 OS_ERR_TASK_INVALID            if you specified a NULL pointer for 'p_task'
 *                                 OS_ERR_TCB_INVALID             if you specified a NULL pointer for 'p_tcb'
@@ -205,11 +294,7 @@ void  OSTaskCreate (OS_TCB        *p_tcb,
                     OS_ERR        *p_err)
 {
     rt_err_t rt_err;
-    
-    (void)q_size;
-    (void)p_ext;
-    (void)opt;
-    (void)stk_limit;
+    CPU_STK_SIZE tls_size = 0;
     
     /*Ƿж*/
     if(rt_interrupt_get_nest()!=0)
@@ -246,6 +331,15 @@ void  OSTaskCreate (OS_TCB        *p_tcb,
         return;        
     }
     
+#if OS_CFG_ISR_POST_DEFERRED_EN > 0u
+    /*ȼ0ж϶д,ûת,ӳٷƳ*/
+    if(prio == 0)
+    {
+        *p_err = OS_ERR_PRIO_INVALID;
+        return;
+    }
+#endif
+    
     /*ջָǷΪNULL*/
     if(p_stk_base == RT_NULL)
     {
@@ -260,23 +354,87 @@ void  OSTaskCreate (OS_TCB        *p_tcb,
         return;
     }
     
-    rt_err = rt_thread_init(p_tcb,
+#if OS_CFG_TLS_TBL_SIZE > 0u
+    /*TLS۱Ӷջײ,OS_OPT_TASK_NO_TLSռ*/
+    if((opt & OS_OPT_TASK_NO_TLS) == 0)
+    {
+        tls_size = OS_TLS_STK_SIZE;
+        if(stk_size <= tls_size)
+        {
+            *p_err = OS_ERR_STK_SIZE_INVALID;
+            return;
+        }
+    }
+#else
+    (void)opt;
+#endif
+    
+    /*ջλǷ(ȥTLS۱)ջΧ*/
+    if(stk_limit >= stk_size - tls_size)
+    {
+        *p_err = OS_ERR_STK_LIMIT_INVALID;
+        return;
+    }
+    
+    rt_err = rt_thread_init(&p_tcb->Task,
                             (const char*)p_name,
-                            p_task,
-                            p_arg,
-                            p_stk_base,
-                            stk_size*sizeof(CPU_STK),/*uCOS-IIIջʱCPU_STKΪλRTTֽΪλҪת*/
+                            OS_TaskEntry,/*ʱҪͷԴ,OS_TaskEntry()*/
+                            p_tcb,
+                            p_stk_base + tls_size,
+                            (stk_size - tls_size)*sizeof(CPU_STK),/*uCOS-IIIջʱCPU_STKΪλRTTֽΪλҪת*/
                             prio,
-                            time_quanta);
+                            OS_SchedRoundRobinQuanta(time_quanta));
     
     *p_err = _err_rtt_to_ucosiii(rt_err);
     if(rt_err != RT_EOK)
     {
         return;
     }
+    
+    p_tcb->PendOn     = OS_TASK_PEND_ON_NOTHING;
+    p_tcb->PendStatus = OS_STATUS_PEND_OK;
+    p_tcb->PendObjPtr = RT_NULL;
+    p_tcb->PendDataPtr = RT_NULL;
+    p_tcb->SemCtr     = 0;
+    p_tcb->TS         = (CPU_TS)0;
+    p_tcb->TimeQuanta = time_quanta;
+    p_tcb->TickCtrPrev = rt_tick_get();
+    p_tcb->TaskState  = OS_TASK_STATE_RDY;
+    p_tcb->ExtPtr     = p_ext;
+    p_tcb->TaskEntryAddr = p_task;
+    p_tcb->TaskEntryArg  = p_arg;
+#if OS_CFG_TLS_TBL_SIZE > 0u
+    OS_TLS_TaskCreate(p_tcb, p_stk_base, opt);
+#endif
+#if OS_CFG_TASK_REG_TBL_SIZE > 0u
+    rt_memset(p_tcb->RegTbl, 0, sizeof(p_tcb->RegTbl));
+#endif
+    p_tcb->StkMarkPtr = (CPU_INT08U *)p_stk_base + stk_size*sizeof(CPU_STK);/*δ,ջҪ*/
+#if OS_CFG_TASK_PROFILE_EN > 0u
+    p_tcb->CtxSwCtr        = 0;
+    p_tcb->CyclesStart     = 0;
+    p_tcb->CyclesTotal     = 0;
+    p_tcb->CyclesTotalPrev = 0;
+    p_tcb->CyclesDelta     = 0;
+    p_tcb->CPUUsage        = 0;
+    p_tcb->CPUUsageMax     = 0;
+#endif
+#if OS_CFG_TASK_STK_LIMIT_EN > 0u
+    p_tcb->StkLimitPtr = p_stk_base + tls_size + stk_limit;/*ջ,λþRTTջײ(TLS۱֮)stk_limitCPU_STK*/
+#else
+    (void)stk_limit;
+#endif
+    p_tcb->Task.user_data = (rt_uint32_t)&p_tcb->Task;/*ΪOSTaskCreate(),OS_TCB_GET()*/
+#if OS_CFG_TASK_Q_EN > 0u
+    p_tcb->MsgPtr     = RT_NULL;
+    p_tcb->MsgSize    = 0;
+    OS_MsgQInit(&p_tcb->MsgQ, &OSMsgPool, q_size);
+#else
+    (void)q_size;
+#endif
 
     /*uCOS-IIIе񴴽൱RTT񴴽+*/
-    rt_err = rt_thread_startup(p_tcb);                 
+    rt_err = rt_thread_startup(&p_tcb->Task);                 
     *p_err = _err_rtt_to_ucosiii(rt_err);
 }
 
@@ -306,7 +464,10 @@ void  OSTaskCreate (OS_TCB        *p_tcb,
 * Note(s)    : 1) 'p_err' gets set to OS_ERR_NONE before OSSched() to allow the returned error code to be monitored even
 *                 for a task that is deleting itself. In this case, 'p_err' MUST point to a global variable that can be
 *                 accessed by another task.
-*              2) ߳ѭִеģɾϵ̣߳RT-Thread ߳ϺԶɾ̣߳ 
+*              2) ڽϢδȡߵϢ黹Ϣ,øTLS;ڵȴOS_Qȴ
+*                 ȴбƳ.p_tcbΪNULLʱǰҲǷOSTaskCreate()߳
+*              3) ʱ,OS_TaskEntry()ͬ黹ڽϢеϢTLS
+*              4) ߳ѭִеģɾϵ̣߳RT-Thread ߳ϺԶɾ̣߳ 
 *                 rt_thread_exit() ɾûֻҪ˽ýӿڵãƼʹøýӿڣ̵߳ô˽
 *                 ڻڶʱʱеô˽ӿɾһ̣߳ʹ÷ǳ٣
 ************************************************************************************************************************
@@ -316,6 +477,9 @@ void  OSTaskDel (OS_TCB  *p_tcb,
                  OS_ERR  *p_err)
 {
     rt_err_t rt_err;
+    rt_thread_t thread;
+    OS_TCB  *p_os_tcb;
+    CPU_SR_ALLOC();
     
     /*Ƿж*/
     if(rt_interrupt_get_nest()!=0)
@@ -325,248 +489,1391 @@ void  OSTaskDel (OS_TCB  *p_tcb,
     }
 
     /*ΪNULLʾɾǰ*/
-    if(p_tcb == RT_NULL)
+    thread = (p_tcb != RT_NULL) ? &p_tcb->Task : rt_thread_self();
+    p_os_tcb = OS_TCB_GET(thread);/*OSTaskCreate()߳ûڽϢкTLS*/
+
+#if OS_CFG_TLS_TBL_SIZE > 0u
+    if(p_os_tcb != RT_NULL)
     {
-        rt_err = rt_thread_detach(rt_thread_self());
-        *p_err = _err_rtt_to_ucosiii(rt_err);   
-        rt_schedule();  
-    } 
-    else
+        OS_TLS_TaskDel(p_os_tcb);/*øTLS*/
+    }
+#endif
+
+    CPU_CRITICAL_ENTER();
+    OS_TaskPendDel(thread);/*OS_QĵȴбƳ,ʱָ*/
+#if OS_CFG_TASK_Q_EN > 0u
+    if(p_os_tcb != RT_NULL)
+    {
+        (void)OS_MsgQFreeAll(&p_os_tcb->MsgQ);
+    }
+#endif
+    rt_err = rt_thread_detach(thread);
+    CPU_CRITICAL_EXIT();
+    *p_err = _err_rtt_to_ucosiii(rt_err);
+
+    if(p_tcb == RT_NULL)
     {
-        rt_err = rt_thread_detach(p_tcb);
-        *p_err = _err_rtt_to_ucosiii(rt_err);   
+        rt_schedule();
     }
 }
 
 /*
 ************************************************************************************************************************
-*                                               RESUME A SUSPENDED TASK
+*                                                    FLUSH TASK's QUEUE
 *
-* Description: This function is called to resume a previously suspended task.  This is the only call that will remove an
-*              explicit task suspension.
+* Description: This function is used to flush the task's internal message queue.
 *
-* Arguments  : p_tcb      Is a pointer to the task's OS_TCB to resume
+* Arguments  : p_tcb       is a pointer to the task's OS_TCB.  Specifying a NULL pointer indicates that you wish to
+*                          flush the message queue of the calling task.
 *
-*              p_err      Is a pointer to a variable that will contain an error code returned by this function
+*              p_err       is a pointer to a variable that will contain an error code returned by this function.
 *
-*                             OS_ERR_NONE                  if the requested task is resumed
-*                           - OS_ERR_STATE_INVALID         if the task is in an invalid state
-*                             OS_ERR_TASK_RESUME_ISR       if you called this function from an ISR
-*                             OS_ERR_TASK_RESUME_SELF      You cannot resume 'self'
-*                             OS_ERR_TASK_NOT_SUSPENDED    if the task to resume has not been suspended
-*                         -------------˵-------------
-*                             OS_ERR_XXXX        ʾԼuCOS-IIIԭĴ
-*                           - OS_ERR_XXXX        ʾôڱݲѾ޷ʹ
-*                           + OS_ERR_RT_XXXX     ʾôΪRTTרô뼯
-*                          ӦòҪAPIصĴжӦ޸
+*                              OS_ERR_NONE           upon success
+*                              OS_ERR_FLUSH_ISR      if you called this function from an ISR
+*                              OS_ERR_TCB_INVALID    if the task was not created by OSTaskCreate()
 *
-* Returns    : none
+* Returns     : The number of entries freed from the queue
 *
-* Note(s)    : 1) uCOS-III֧Ƕ׹/,5,5,񼴿
-*                 RTT֧Ƕ׹/,˸ú޷ʵǶ׽
+* Note(s)     : 1) You should use this function with great care because, when to flush the queue, you LOOSE the
+*                  references to what the queue entries are pointing to and thus, you could cause 'memory leaks'.  In
+*                  other words, the data you are pointing to that's being referenced by the queue entries should, most
+*                  likely, need to be de-allocated (i.e. freed).
 ************************************************************************************************************************
 */
 
-void  OSTaskResume (OS_TCB  *p_tcb,
-                    OS_ERR  *p_err)
+#if OS_CFG_TASK_Q_EN > 0u
+OS_MSG_QTY  OSTaskQFlush (OS_TCB  *p_tcb,
+                          OS_ERR  *p_err)
 {
-    rt_err_t rt_err;
+    OS_MSG_QTY  entries;
+    CPU_SR_ALLOC();
     
     /*Ƿж*/
     if(rt_interrupt_get_nest()!=0)
     {
-        *p_err = OS_ERR_TASK_RESUME_ISR;
-        return;
+        *p_err = OS_ERR_FLUSH_ISR;
+        return 0;
     }
-
-    /*TCBָǷΪ*/
-    if(p_tcb == RT_NULL)
-    {
-        /*uCOS-IIIԴ,ͼԼΪ*/
-        *p_err = OS_ERR_TASK_RESUME_SELF;
-        return;
-    }     
     
-    /*ǷͼԼָԼ*/
-    if(rt_thread_self() == p_tcb)
+    /*TCBָΪNULL,ʾǰ*/
+    if(p_tcb == RT_NULL)
     {
-        *p_err = OS_ERR_TASK_RESUME_SELF;
-        return;
+        p_tcb = (OS_TCB *)rt_thread_self();
     }
     
-    /*Ƿûб*/
-    if((p_tcb->stat & RT_THREAD_STAT_MASK) != RT_THREAD_SUSPEND)
+    /*ֻOSTaskCreate()OS_TCBչԱ*/
+    if(OS_TCB_GET(&p_tcb->Task) == RT_NULL)
     {
-        *p_err = OS_ERR_TASK_NOT_SUSPENDED;
-        return;
+        *p_err = OS_ERR_TCB_INVALID;
+        return 0;
     }
     
-    rt_err = rt_thread_resume(p_tcb);
+    CPU_CRITICAL_ENTER();
+    entries = OS_MsgQFreeAll(&p_tcb->MsgQ);
+    CPU_CRITICAL_EXIT();
     
-    *p_err = _err_rtt_to_ucosiii(rt_err);
+    *p_err = OS_ERR_NONE;
+    return entries;
 }
+#endif
 
 /*
 ************************************************************************************************************************
-*                                                    STACK CHECKING
+*                                                  WAIT FOR A MESSAGE
 *
-* Description: This function is called to calculate the amount of free memory left on the specified task's stack.
+* Description: This function causes the current task to wait for a message to be posted to it.
 *
-* Arguments  : p_tcb       is a pointer to the TCB of the task to check.  If you specify a NULL pointer then
-*                          you are specifying that you want to check the stack of the current task.
+* Arguments  : timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will wait for a
+*                            message to arrive up to the amount of time specified by this argument.
+*                            If you specify 0, however, your task will wait forever or, until a message arrives.
 *
-*              p_free      is a pointer to a variable that will receive the number of free 'entries' on the task's stack.
+*              opt           determines whether the user wants to block if the task's queue is empty or not:
 *
-*              p_used      is a pointer to a variable that will receive the number of used 'entries' on the task's stack.
+*                                OS_OPT_PEND_BLOCKING
+*                                OS_OPT_PEND_NON_BLOCKING
 *
-*              p_used_max  is a pointer to a variable that will receive the maximum number of used 'entries' on the task's stack.
+*              p_msg_size    is a pointer to a variable that will receive the size of the message
 *
-*              p_err       is a pointer to a variable that will contain an error code.
+*              p_ts          is a pointer to a variable that will receive the timestamp of when the message was
+*                            received.  If you pass a NULL pointer (i.e. (CPU_TS *)0) then you will not get the
+*                            timestamp.  In other words, passing a NULL pointer is valid and indicates that you don't
+*                            need the timestamp.
+*                            -------------˵-------------
+*                            ϢͶ(ȴֹ)ʱʱ(OS_TS_GET()ֵ);ʱʱΪ0
 *
-*                              OS_ERR_NONE               upon success
-*                              OS_ERR_PTR_INVALID        if either 'p_free' or 'p_used' are NULL pointers
-*                              OS_ERR_TASK_NOT_EXIST     if the stack pointer of the task is a NULL pointer
-*                            - OS_ERR_TASK_OPT           if you did NOT specified OS_OPT_TASK_STK_CHK when the task
-*                                                        was created
-*                              OS_ERR_TASK_STK_CHK_ISR   you called this function from an ISR
-*                         -------------˵-------------
-*                             OS_ERR_XXXX        ʾԼuCOS-IIIԭĴ
-*                           - OS_ERR_XXXX        ʾôڱݲѾ޷ʹ
-*                           + OS_ERR_RT_XXXX     ʾôΪRTTרô뼯
-*                          ӦòҪAPIصĴжӦ޸
-* Returns    : none
+*              p_err         is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
 *
-* Note(s)    : 1) ԭ溯ȡʵʱջʹ,ڱݲиúȡĽֹǰʱ̵Ķջʹúʵʱʹ/ʣ,
-*                 ԭ溯һp_used_max,ҪԭЧǰ(߳)Ķջʹ
+*                                OS_ERR_NONE               The call was successful and your task received a message.
+*                                OS_ERR_OPT_INVALID        if you specified an invalid option
+*                                OS_ERR_PEND_ABORT         the pend was aborted
+*                                OS_ERR_PEND_ISR           If you called this function from an ISR and the result
+*                                OS_ERR_PEND_WOULD_BLOCK   If you specified non-blocking but the queue was not empty
+*                                OS_ERR_PTR_INVALID        if you passed a NULL pointer for 'p_msg_size'
+*                                OS_ERR_SCHED_LOCKED       If the scheduler is locked
+*                                OS_ERR_TIMEOUT            A message was not received within the specified timeout
+*                                OS_ERR_TCB_INVALID        if the task was not created by OSTaskCreate()
+*
+* Returns    : A pointer to the message received or a NULL pointer upon error.
+*
+* Note(s)    : 1) It is possible to receive NULL pointers when there are no errors.
+*              2) ֻOSTaskCreate()
 ************************************************************************************************************************
 */
 
-void  OSTaskStkChk (OS_TCB        *p_tcb,
-                    CPU_STK_SIZE  *p_free,
-                    CPU_STK_SIZE  *p_used,
-                    CPU_STK_SIZE  *p_used_max,
-                    OS_ERR        *p_err)
+#if OS_CFG_TASK_Q_EN > 0u
+void  *OSTaskQPend (OS_TICK       timeout,
+                    OS_OPT        opt,
+                    OS_MSG_SIZE  *p_msg_size,
+                    CPU_TS       *p_ts,
+                    OS_ERR       *p_err)
 {
-    rt_uint32_t stack_size;
-    rt_uint32_t stack_used_max;
-    rt_uint32_t stack_used;
-    rt_uint32_t stack_free;
-    rt_uint8_t *ptr;
+    OS_TCB      *p_tcb;
+    void        *p_void;
+    rt_int32_t   time;
+    CPU_SR_ALLOC();
     
-    if(p_free == RT_NULL ||
-       p_used == RT_NULL
-    )
+    if(p_ts != RT_NULL)
     {
-        *p_err = OS_ERR_PTR_INVALID;
-        return;
+        *p_ts = (CPU_TS)0;/*ʱʱʱΪ0*/
     }
-        
+    
     /*Ƿж*/
     if(rt_interrupt_get_nest()!=0)
     {
-        *p_err = OS_ERR_TASK_STK_CHK_ISR;
-        return;
-    }   
+        *p_err = OS_ERR_PEND_ISR;
+        return RT_NULL;
+    }
     
-    /*TCBָΪNULL,ʾǰ߳*/
-    if(p_tcb ==RT_NULL)
+    /*Ƿ*/
+    if(rt_critical_level() > 0)
     {
-        p_tcb = rt_thread_self();
+        *p_err = OS_ERR_SCHED_LOCKED;
+        return RT_NULL;
     }
     
-    /*ջǷΪNULL*/
-    if(p_tcb->stack_addr == RT_NULL)
+    /*ϢָǷΪNULL*/
+    if(p_msg_size == RT_NULL)
     {
-        *p_err = OS_ERR_TASK_NOT_EXIST;
-        return;        
+        *p_err = OS_ERR_PTR_INVALID;
+        return RT_NULL;
     }
     
-    *p_err = OS_ERR_NONE;
+    /*RTTtimeoutΪ0ʾ,ΪRT_WAITING_FOREVERʾ,
+    uCOS-IIIͬ,Ҫת*/
+    if(opt == OS_OPT_PEND_BLOCKING)
+    {
+        if(timeout == 0)/*uCOS-IIItimeout=0ʾ*/
+        {
+            time = RT_WAITING_FOREVER;
+        }
+        else
+        {
+            time = timeout;
+        }
+    }
+    else if (opt == OS_OPT_PEND_NON_BLOCKING)
+    {
+        time = 0;/*RTTtimeoutΪ0ʾ*/
+    }
+    else
+    {
+        *p_err = OS_ERR_OPT_INVALID;/*optЧ*/
+        *p_msg_size = 0;
+        return RT_NULL;
+    }
     
-    /*ջʹ*/
-    ptr = (rt_uint8_t *)p_tcb->stack_addr;
-    while (*ptr == '#')ptr ++;
-    stack_size = p_tcb->stack_size;
-    stack_used_max = p_tcb->stack_size - ((rt_ubase_t) ptr - (rt_ubase_t) p_tcb->stack_addr);
+    /*ֻOSTaskCreate()ڽϢ*/
+    p_tcb = OS_TCB_GET(rt_thread_self());
+    if(p_tcb == RT_NULL)
+    {
+        *p_err = OS_ERR_TCB_INVALID;
+        *p_msg_size = 0;
+        return RT_NULL;
+    }
     
-    /*ջʵʱʹ*/
-    stack_used = (rt_ubase_t)p_tcb->stack_addr + p_tcb->stack_size - (rt_ubase_t)p_tcb->sp;
-    stack_free = stack_size - stack_used;
+    CPU_CRITICAL_ENTER();
+    p_void = OS_MsgQGet(&p_tcb->MsgQ, p_msg_size, p_ts, p_err);/*Ϣֱȡ*/
+    if(*p_err == OS_ERR_NONE)
+    {
+        CPU_CRITICAL_EXIT();
+        return p_void;
+    }
     
-    *p_used_max = stack_used_max / sizeof(CPU_STK_SIZE);
-    *p_used = stack_used / sizeof(CPU_STK_SIZE);
-    *p_free = stack_free / sizeof(CPU_STK_SIZE);
+    if(time == 0)/*ΪҲ*/
+    {
+        CPU_CRITICAL_EXIT();
+        *p_err = OS_ERR_PEND_WOULD_BLOCK;
+        *p_msg_size = 0;
+        return RT_NULL;
+    }
+    
+    OS_TaskBlock(p_tcb, OS_TASK_PEND_ON_TASK_Q, time, cpu_sr);/*ȴ,ʱѿж*/
+    
+    switch(p_tcb->PendStatus)
+    {
+        case OS_STATUS_PEND_OK:
+            if(p_ts != RT_NULL)
+            {
+                *p_ts = p_tcb->TS;
+            }
+            *p_msg_size = p_tcb->MsgSize;
+            *p_err = OS_ERR_NONE;
+            return p_tcb->MsgPtr;
+        
+        case OS_STATUS_PEND_TIMEOUT:
+            *p_err = OS_ERR_TIMEOUT;
+            break;
+        
+        case OS_STATUS_PEND_ABORT:
+        default:
+            if(p_ts != RT_NULL)
+            {
+                *p_ts = p_tcb->TS;
+            }
+            *p_err = OS_ERR_PEND_ABORT;
+            break;
+    }
+    *p_msg_size = 0;
+    return RT_NULL;
 }
+#endif
 
 /*
 ************************************************************************************************************************
-*                                                   SUSPEND A TASK
+*                                              ABORT WAITING FOR A MESSAGE
 *
-* Description: This function is called to suspend a task.  The task can be the calling task if 'p_tcb' is a NULL pointer
-*              or the pointer to the TCB of the calling task.
+* Description: This function aborts & readies the task specified.  This function should be used to fault-abort the wait
+*              for a message, rather than to normally post the message to the task via OSTaskQPost().
 *
-* Arguments  : p_tcb    is a pointer to the TCB to suspend.
-*                       If p_tcb is a NULL pointer then, suspend the current task.
+* Arguments  : p_tcb     is a pointer to the task to pend abort
 *
-*              p_err    is a pointer to a variable that will receive an error code from this function.
+*              opt       provides options for this function:
 *
-*                           OS_ERR_NONE                      if the requested task is suspended
-*                           OS_ERR_SCHED_LOCKED              you can't suspend the current task is the scheduler is
-*                                                            locked
-*                           OS_ERR_TASK_SUSPEND_ISR          if you called this function from an ISR
-*                         - OS_ERR_TASK_SUSPEND_IDLE         if you attempted to suspend the idle task which is not
-*                                                            allowed.
-*                         - OS_ERR_TASK_SUSPEND_INT_HANDLER  if you attempted to suspend the idle task which is not
-*                                                            allowed.
-*                       -------------˵-------------
-*                           OS_ERR_XXXX        ʾԼuCOS-IIIԭĴ
-*                         - OS_ERR_XXXX        ʾôڱݲѾ޷ʹ
-*                         + OS_ERR_RT_XXXX     ʾôΪRTTרô뼯
-*                        ӦòҪAPIصĴжӦ޸
+*                            OS_OPT_POST_NONE         No option specified
+*                            OS_OPT_POST_NO_SCHED     Indicates that the scheduler will not be called.
 *
-* Note(s)    : 1) You should use this function with great care.  If you suspend a task that is waiting for an event
-*                 (i.e. a message, a semaphore, a queue ...) you will prevent this task from running when the event
-*                 arrives.
-*              2) uCOS-III֧Ƕ׹/,5,5,񼴿
-*                 RTT֧Ƕ׹/,˸ú޷ʵǶ׹
+*              p_err     is a pointer to a variable that will contain an error code returned by this function.
+*
+*                            OS_ERR_NONE              If the task was readied and informed of the aborted wait
+*                            OS_ERR_OPT_INVALID       if you specified an invalid option
+*                            OS_ERR_PEND_ABORT_ISR    If you called this function from an ISR
+*                            OS_ERR_PEND_ABORT_NONE   If task was not pending on a message and thus there is nothing to
+*                                                     abort.
+*                            OS_ERR_PEND_ABORT_SELF   If you passed a NULL pointer for 'p_tcb'
+*
+* Returns    : == DEF_FALSE   if task was not waiting for a message, or upon error.
+*              == DEF_TRUE    if task was waiting for a message and was readied and informed.
 ************************************************************************************************************************
 */
 
-void   OSTaskSuspend (OS_TCB  *p_tcb,
-                      OS_ERR  *p_err)
+#if (OS_CFG_TASK_Q_EN > 0u) && (OS_CFG_TASK_Q_PEND_ABORT_EN > 0u)
+CPU_BOOLEAN  OSTaskQPendAbort (OS_TCB  *p_tcb,
+                               OS_OPT   opt,
+                               OS_ERR  *p_err)
 {
-    rt_err_t rt_err;
+    CPU_BOOLEAN  rdy;
+    CPU_SR_ALLOC();
     
     /*Ƿж*/
     if(rt_interrupt_get_nest()!=0)
     {
-        *p_err = OS_ERR_TASK_SUSPEND_ISR;
-        return;
+        *p_err = OS_ERR_PEND_ABORT_ISR;
+        return DEF_FALSE;
     }
-
-    /*Ƿ*/
-    if(rt_critical_level() > 0)
+    
+    if(opt != OS_OPT_POST_NONE && opt != OS_OPT_POST_NO_SCHED)
     {
-        *p_err = OS_ERR_SCHED_LOCKED;
-        return;         
+        *p_err = OS_ERR_OPT_INVALID;
+        return DEF_FALSE;
     }
-
-    /*TCBָǷΪ,Ϊձʾɾǰ߳*/
-    if(p_tcb == RT_NULL)
+    
+    /*ֹԼĵȴ*/
+    if(p_tcb == RT_NULL || &p_tcb->Task == rt_thread_self())
     {
-        rt_err = rt_thread_suspend(rt_thread_self());
-        rt_schedule();/* RTTҪ,ԼҪrt_sheduleе*/
-    } 
-    else
+        *p_err = OS_ERR_PEND_ABORT_SELF;
+        return DEF_FALSE;
+    }
+    
+    CPU_CRITICAL_ENTER();
+    rdy = OS_TaskRdy(p_tcb, OS_TASK_PEND_ON_TASK_Q, OS_STATUS_PEND_ABORT);
+    if(rdy == DEF_TRUE)
     {
-        rt_err = rt_thread_suspend(p_tcb);
-        if(rt_thread_self() == p_tcb)/*ǷҪԼ*/
-        {
-            rt_schedule();/* RTTҪ,ԼҪrt_sheduleе*/
-        }
+        p_tcb->TS = OS_TS_GET();/*ֹȴʱ*/
     }
-        
-    *p_err = _err_rtt_to_ucosiii(rt_err);
+    CPU_CRITICAL_EXIT();
+    
+    if(rdy == DEF_FALSE)
+    {
+        *p_err = OS_ERR_PEND_ABORT_NONE;
+        return DEF_FALSE;
+    }
+    
+    if(opt != OS_OPT_POST_NO_SCHED)
+    {
+        OSSched();
+    }
+    
+    *p_err = OS_ERR_NONE;
+    return DEF_TRUE;
+}
+#endif
+
+/*
+************************************************************************************************************************
+*                                               POST MESSAGE TO A TASK
+*
+* Description: This function sends a message to a task
+*
+* Arguments  : p_tcb      is a pointer to the TCB of the task receiving a message.  If you specify a NULL pointer then
+*                         the message will be posted to the task's queue of the calling task.  In other words, you'd be
+*                         posting a message to yourself.
+*
+*              p_void     is a pointer to the message to send.
+*
+*              msg_size   is the size of the message sent (in #bytes)
+*
+*              opt        specifies whether the post will be FIFO or LIFO:
+*
+*                             OS_OPT_POST_FIFO       Post at the end   of the queue
+*                             OS_OPT_POST_LIFO       Post at the front of the queue
+*
+*                             OS_OPT_POST_NO_SCHED   Do not run the scheduler after the post
+*
+*                          Note(s): 1) OS_OPT_POST_NO_SCHED can be added with one of the other options.
+*
+*              p_err      is a pointer to a variable that will hold the error code associated
+*                         with the outcome of this call.  Errors can be:
+*
+*                             OS_ERR_NONE            The call was successful and the message was sent
+*                             OS_ERR_MSG_POOL_EMPTY  If there are no more OS_MSGs available from the pool
+*                             OS_ERR_OPT_INVALID     if you specified an invalid option
+*                             OS_ERR_Q_MAX           If the queue is full
+*                             OS_ERR_INT_Q_FULL      If the post was deferred but the ISR queue is full (ӳٷʱ)
+*                             OS_ERR_TCB_INVALID     if the task was not created by OSTaskCreate()
+*
+* Returns    : none
+*
+* Note(s)    : 1) ڵȴʱ,Ϣֱӽ,ռϢ
+************************************************************************************************************************
+*/
+
+#if OS_CFG_TASK_Q_EN > 0u
+void  OSTaskQPost (OS_TCB       *p_tcb,
+                   void         *p_void,
+                   OS_MSG_SIZE   msg_size,
+                   OS_OPT        opt,
+                   OS_ERR       *p_err)
+{
+    CPU_TS  ts;
+    CPU_SR_ALLOC();
+    
+    ts = OS_TS_GET();/*Ͷݵʱ*/
+    
+    if((opt & ~(OS_OPT_POST_LIFO | OS_OPT_POST_NO_SCHED)) != 0)
+    {
+        *p_err = OS_ERR_OPT_INVALID;
+        return;
+    }
+    
+    /*TCBָΪNULL,ʾǰԼ*/
+    if(p_tcb == RT_NULL)
+    {
+        p_tcb = (OS_TCB *)rt_thread_self();
+    }
+    
+    /*ֻOSTaskCreate()OS_TCBչԱ*/
+    if(OS_TCB_GET(&p_tcb->Task) == RT_NULL)
+    {
+        *p_err = OS_ERR_TCB_INVALID;
+        return;
+    }
+    
+#if OS_CFG_ISR_POST_DEFERRED_EN > 0u
+    if(rt_interrupt_get_nest()!=0)/*жֻдж϶,ж϶дͶ*/
+    {
+        OS_IntQPost(OS_OBJ_TYPE_TASK_MSG, (void *)p_tcb, p_void, msg_size, 0, opt, p_err);
+        return;
+    }
+#endif
+    
+    CPU_CRITICAL_ENTER();
+    if(p_tcb->PendOn == OS_TASK_PEND_ON_TASK_Q)/*ڵȴ,ֱӽϢ*/
+    {
+        p_tcb->MsgPtr  = p_void;
+        p_tcb->MsgSize = msg_size;
+        p_tcb->TS      = ts;
+        (void)OS_TaskRdy(p_tcb, OS_TASK_PEND_ON_TASK_Q, OS_STATUS_PEND_OK);
+        CPU_CRITICAL_EXIT();
+        if((opt & OS_OPT_POST_NO_SCHED) == 0)
+        {
+            OSSched();
+        }
+        *p_err = OS_ERR_NONE;
+        return;
+    }
+    
+    OS_MsgQPut(&p_tcb->MsgQ, p_void, msg_size, opt, ts, p_err);/*ϢȡһOS_MSGҵڽϢ*/
+    CPU_CRITICAL_EXIT();
+}
+#endif
+
+/*
+************************************************************************************************************************
+*                                               GET THE CURRENT VALUE OF A TASK REGISTER
+*
+* Description: This function is called to obtain the current value of a task register.  Task registers are application
+*              specific and can be used to store task specific values such as 'error numbers' (i.e. errno), statistics,
+*              etc.
+*
+* Arguments  : p_tcb     is a pointer to the OS_TCB of the task you want to read the register from.  If 'p_tcb' is a
+*                        NULL pointer then you will get the register of the current task.
+*
+*              id        is the 'id' of the desired task variable.  Note that the 'id' must be less than
+*                        OS_CFG_TASK_REG_TBL_SIZE
+*
+*              p_err     is a pointer to a variable that will hold an error code related to this call.
+*
+*                            OS_ERR_NONE            if the call was successful
+*                            OS_ERR_REG_ID_INVALID  if the 'id' is not between 0 and OS_CFG_TASK_REG_TBL_SIZE-1
+*                            OS_ERR_TCB_INVALID     if the task was not created by OSTaskCreate()
+*
+* Returns    : The current value of the task's register or 0 if an error is detected.
+*
+* Note(s)    : 1) ĴOS_TCB,±ֱӶд,ֻOSTaskCreate()
+************************************************************************************************************************
+*/
+
+#if OS_CFG_TASK_REG_TBL_SIZE > 0u
+OS_REG  OSTaskRegGet (OS_TCB     *p_tcb,
+                      OS_REG_ID   id,
+                      OS_ERR     *p_err)
+{
+    OS_REG  value;
+    CPU_SR_ALLOC();
+    
+#if OS_CFG_ARG_CHK_EN > 0u
+    if(id >= OS_CFG_TASK_REG_TBL_SIZE)
+    {
+        *p_err = OS_ERR_REG_ID_INVALID;
+        return 0;
+    }
+#endif
+    
+    /*TCBָΪNULL,ʾǰ*/
+    if(p_tcb == RT_NULL)
+    {
+        p_tcb = (OS_TCB *)rt_thread_self();
+    }
+    
+    /*ֻOSTaskCreate()OS_TCBչԱ*/
+    if(OS_TCB_GET(&p_tcb->Task) == RT_NULL)
+    {
+        *p_err = OS_ERR_TCB_INVALID;
+        return 0;
+    }
+    
+    CPU_CRITICAL_ENTER();
+    value = p_tcb->RegTbl[id];
+    CPU_CRITICAL_EXIT();
+    
+    *p_err = OS_ERR_NONE;
+    return value;
+}
+
+/*
+************************************************************************************************************************
+*                                    ALLOCATE THE NEXT AVAILABLE TASK REGISTER ID
+*
+* Description: This function is called to obtain a task register ID.  This function thus allows task registers IDs to be
+*              allocated dynamically instead of statically.
+*
+* Arguments  : p_err       is a pointer to a variable that will hold an error code related to this call.
+*
+*                            OS_ERR_NONE               if the call was successful
+*                            OS_ERR_NO_MORE_ID_AVAIL   if you are attempting to assign more task register IDs than you 
+*                                                      have available through OS_CFG_TASK_REG_TBL_SIZE.
+*
+* Returns    : The next available task register 'id' or OS_CFG_TASK_REG_TBL_SIZE if an error is detected.
+************************************************************************************************************************
+*/
+
+OS_REG_ID  OSTaskRegGetID (OS_ERR  *p_err)
+{
+    OS_REG_ID  id;
+    CPU_SR_ALLOC();
+    
+    CPU_CRITICAL_ENTER();
+    if(OSTaskRegNextAvailID >= OS_CFG_TASK_REG_TBL_SIZE)/*IDѷ*/
+    {
+        CPU_CRITICAL_EXIT();
+        *p_err = OS_ERR_NO_MORE_ID_AVAIL;
+        return (OS_REG_ID)OS_CFG_TASK_REG_TBL_SIZE;
+    }
+    id = OSTaskRegNextAvailID;
+    OSTaskRegNextAvailID++;
+    CPU_CRITICAL_EXIT();
+    
+    *p_err = OS_ERR_NONE;
+    return id;
+}
+
+/*
+************************************************************************************************************************
+*                                       SET THE CURRENT VALUE OF A TASK REGISTER
+*
+* Description: This function is called to change the current value of a task register.  Task registers are application
+*              specific and can be used to store task specific values such as 'error numbers' (i.e. errno), statistics,
+*              etc.
+*
+* Arguments  : p_tcb     is a pointer to the OS_TCB of the task you want to set the register for.  If 'p_tcb' is a NULL
+*                        pointer then you will change the register of the current task.
+*
+*              id        is the 'id' of the desired task register.  Note that the 'id' must be less than
+*                        OS_CFG_TASK_REG_TBL_SIZE
+*
+*              value     is the desired value for the task register.
+*
+*              p_err     is a pointer to a variable that will hold an error code related to this call.
+*
+*                            OS_ERR_NONE            if the call was successful
+*                            OS_ERR_REG_ID_INVALID  if the 'id' is not between 0 and OS_CFG_TASK_REG_TBL_SIZE-1
+*                            OS_ERR_TCB_INVALID     if the task was not created by OSTaskCreate()
+*
+* Returns    : none
+************************************************************************************************************************
+*/
+
+void  OSTaskRegSet (OS_TCB     *p_tcb,
+                    OS_REG_ID   id,
+                    OS_REG      value,
+                    OS_ERR     *p_err)
+{
+    CPU_SR_ALLOC();
+    
+#if OS_CFG_ARG_CHK_EN > 0u
+    if(id >= OS_CFG_TASK_REG_TBL_SIZE)
+    {
+        *p_err = OS_ERR_REG_ID_INVALID;
+        return;
+    }
+#endif
+    
+    /*TCBָΪNULL,ʾǰ*/
+    if(p_tcb == RT_NULL)
+    {
+        p_tcb = (OS_TCB *)rt_thread_self();
+    }
+    
+    /*ֻOSTaskCreate()OS_TCBչԱ*/
+    if(OS_TCB_GET(&p_tcb->Task) == RT_NULL)
+    {
+        *p_err = OS_ERR_TCB_INVALID;
+        return;
+    }
+    
+    CPU_CRITICAL_ENTER();
+    p_tcb->RegTbl[id] = value;
+    CPU_CRITICAL_EXIT();
+    
+    *p_err = OS_ERR_NONE;
+}
+#endif
+
+/*
+************************************************************************************************************************
+*                                               RESUME A SUSPENDED TASK
+*
+* Description: This function is called to resume a previously suspended task.  This is the only call that will remove an
+*              explicit task suspension.
+*
+* Arguments  : p_tcb      Is a pointer to the task's OS_TCB to resume
+*
+*              p_err      Is a pointer to a variable that will contain an error code returned by this function
+*
+*                             OS_ERR_NONE                  if the requested task is resumed
+*                           - OS_ERR_STATE_INVALID         if the task is in an invalid state
+*                             OS_ERR_TASK_RESUME_ISR       if you called this function from an ISR
+*                             OS_ERR_TASK_RESUME_SELF      You cannot resume 'self'
+*                             OS_ERR_TASK_NOT_SUSPENDED    if the task to resume has not been suspended
+*                         -------------˵-------------
+*                             OS_ERR_XXXX        ʾԼuCOS-IIIԭĴ
+*                           - OS_ERR_XXXX        ʾôڱݲѾ޷ʹ
+*                           + OS_ERR_RT_XXXX     ʾôΪRTTרô뼯
+*                          ӦòҪAPIصĴжӦ޸
+*
+* Returns    : none
+*
+* Note(s)    : 1) uCOS-III֧Ƕ׹/,5,5,񼴿
+*                 RTT֧Ƕ׹/,˸ú޷ʵǶ׽
+*              2) һʱб,صʱ״̬,ʱںž
+************************************************************************************************************************
+*/
+
+void  OSTaskResume (OS_TCB  *p_tcb,
+                    OS_ERR  *p_err)
+{
+    rt_err_t rt_err;
+    CPU_SR_ALLOC();
+    
+    /*Ƿж*/
+    if(rt_interrupt_get_nest()!=0)
+    {
+        *p_err = OS_ERR_TASK_RESUME_ISR;
+        return;
+    }
+
+    /*TCBָǷΪ*/
+    if(p_tcb == RT_NULL)
+    {
+        /*uCOS-IIIԴ,ͼԼΪ*/
+        *p_err = OS_ERR_TASK_RESUME_SELF;
+        return;
+    }     
+    
+    /*ǷͼԼָԼ*/
+    if(rt_thread_self() == &p_tcb->Task)
+    {
+        *p_err = OS_ERR_TASK_RESUME_SELF;
+        return;
+    }
+    
+    if(OS_TCB_GET(&p_tcb->Task) != RT_NULL)/*OSTaskCreate()TaskStateж*/
+    {
+        CPU_CRITICAL_ENTER();
+        if(p_tcb->TaskState == OS_TASK_STATE_DLY_SUSPENDED)
+        {
+            p_tcb->TaskState = OS_TASK_STATE_DLY;/*ʱδ,صʱ״̬*/
+            CPU_CRITICAL_EXIT();
+            *p_err = OS_ERR_NONE;
+            return;
+        }
+        if(p_tcb->TaskState != OS_TASK_STATE_SUSPENDED)
+        {
+            CPU_CRITICAL_EXIT();
+            *p_err = OS_ERR_TASK_NOT_SUSPENDED;
+            return;
+        }
+        p_tcb->TaskState = OS_TASK_STATE_RDY;
+        CPU_CRITICAL_EXIT();
+    }
+    /*Ƿûб*/
+    else if((p_tcb->Task.stat & RT_THREAD_STAT_MASK) != RT_THREAD_SUSPEND)
+    {
+        *p_err = OS_ERR_TASK_NOT_SUSPENDED;
+        return;
+    }
+    
+    rt_err = rt_thread_resume(&p_tcb->Task);
+    
+    *p_err = _err_rtt_to_ucosiii(rt_err);
+}
+
+/*
+************************************************************************************************************************
+*                                              WAIT FOR A TASK SEMAPHORE
+*
+* Description: This function is called to block the current task until a signal is sent by another task or ISR.
+*
+* Arguments  : timeout       is the amount of time you are will to wait for the signal
+*
+*              opt           determines whether the user wants to block if a semaphore post was not received:
+*
+*                                OS_OPT_PEND_BLOCKING
+*                                OS_OPT_PEND_NON_BLOCKING
+*
+*              p_ts          is a pointer to a variable that will receive the timestamp of when the semaphore was posted
+*                            or pend aborted.  If you pass a NULL pointer (i.e. (CPU_TS *)0) then you will not get the
+*                            timestamp.  In other words, passing a NULL pointer is valid and indicates that you don't
+*                            need the timestamp.
+*                            -------------˵-------------
+*                            źһαͶ(ȴֹ)ʱʱ(OS_TS_GET()ֵ);ʱʱΪ0
+*
+*              p_err         is a pointer to an error code that will be set by this function
+*
+*                                OS_ERR_NONE               The call was successful and your task received a signal.
+*                                OS_ERR_OPT_INVALID        if you specified an invalid option
+*                                OS_ERR_PEND_ABORT         If the pend was aborted
+*                                OS_ERR_PEND_ISR           If you called this function from an ISR and the result
+*                                OS_ERR_PEND_WOULD_BLOCK   If you specified non-blocking but no signal was received
+*                                OS_ERR_SCHED_LOCKED       If the scheduler is locked
+*                                OS_ERR_TIMEOUT            A signal was not received within the specified timeout
+*                                OS_ERR_TCB_INVALID        if the task was not created by OSTaskCreate()
+*
+* Returns    : The current count of signals the task received, 0 if none.
+*
+* Note(s)    : 1) ֻOSTaskCreate()
+************************************************************************************************************************
+*/
+
+OS_SEM_CTR  OSTaskSemPend (OS_TICK   timeout,
+                           OS_OPT    opt,
+                           CPU_TS   *p_ts,
+                           OS_ERR   *p_err)
+{
+    OS_TCB      *p_tcb;
+    OS_SEM_CTR   ctr;
+    rt_int32_t   time;
+    CPU_SR_ALLOC();
+    
+    if(p_ts != RT_NULL)
+    {
+        *p_ts = (CPU_TS)0;/*ʱʱʱΪ0*/
+    }
+    
+    /*Ƿж*/
+    if(rt_interrupt_get_nest()!=0)
+    {
+        *p_err = OS_ERR_PEND_ISR;
+        return 0;
+    }
+    
+    /*Ƿ*/
+    if(rt_critical_level() > 0)
+    {
+        *p_err = OS_ERR_SCHED_LOCKED;
+        return 0;
+    }
+    
+    /*RTTtimeoutΪ0ʾ,ΪRT_WAITING_FOREVERʾ,
+    uCOS-IIIͬ,Ҫת*/
+    if(opt == OS_OPT_PEND_BLOCKING)
+    {
+        if(timeout == 0)/*uCOS-IIItimeout=0ʾ*/
+        {
+            time = RT_WAITING_FOREVER;
+        }
+        else
+        {
+            time = timeout;
+        }
+    }
+    else if (opt == OS_OPT_PEND_NON_BLOCKING)
+    {
+        time = 0;/*RTTtimeoutΪ0ʾ*/
+    }
+    else
+    {
+        *p_err = OS_ERR_OPT_INVALID;/*optЧ*/
+        return 0;
+    }
+    
+    /*ֻOSTaskCreate()ڽź*/
+    p_tcb = OS_TCB_GET(rt_thread_self());
+    if(p_tcb == RT_NULL)
+    {
+        *p_err = OS_ERR_TCB_INVALID;
+        return 0;
+    }
+    
+    CPU_CRITICAL_ENTER();
+    if(p_tcb->SemCtr > 0)/*Ѿյź*/
+    {
+        p_tcb->SemCtr--;
+        ctr = p_tcb->SemCtr;
+        if(p_ts != RT_NULL)
+        {
+            *p_ts = p_tcb->TS;
+        }
+        CPU_CRITICAL_EXIT();
+        *p_err = OS_ERR_NONE;
+        return ctr;
+    }
+    
+    if(time == 0)/*ûյźҲ*/
+    {
+        CPU_CRITICAL_EXIT();
+        *p_err = OS_ERR_PEND_WOULD_BLOCK;
+        return 0;
+    }
+    
+    OS_TaskBlock(p_tcb, OS_TASK_PEND_ON_TASK_SEM, time, cpu_sr);/*ȴ,ʱѿж*/
+    
+    switch(p_tcb->PendStatus)
+    {
+        case OS_STATUS_PEND_OK:
+            if(p_ts != RT_NULL)
+            {
+                *p_ts = p_tcb->TS;
+            }
+            *p_err = OS_ERR_NONE;
+            return p_tcb->SemCtr;
+        
+        case OS_STATUS_PEND_TIMEOUT:
+            *p_err = OS_ERR_TIMEOUT;
+            break;
+        
+        case OS_STATUS_PEND_ABORT:
+        default:
+            if(p_ts != RT_NULL)
+            {
+                *p_ts = p_tcb->TS;
+            }
+            *p_err = OS_ERR_PEND_ABORT;
+            break;
+    }
+    return 0;
+}
+
+/*
+************************************************************************************************************************
+*                                              ABORT WAITING FOR A SIGNAL
+*
+* Description: This function aborts & readies the task specified.  This function should be used to fault-abort the wait
+*              for a signal, rather than to normally post the signal to the task via OSTaskSemPost().
+*
+* Arguments  : p_tcb     is a pointer to the task to pend abort
+*
+*              opt       provides options for this function:
+*
+*                            OS_OPT_POST_NONE         No option selected
+*                            OS_OPT_POST_NO_SCHED     Indicates that the scheduler will not be called.
+*
+*              p_err     is a pointer to a variable that will contain an error code returned by this function.
+*
+*                            OS_ERR_NONE              If the task was readied and informed of the aborted wait
+*                            OS_ERR_OPT_INVALID       if you specified an invalid option
+*                            OS_ERR_PEND_ABORT_ISR    If you tried calling this function from an ISR
+*                            OS_ERR_PEND_ABORT_NONE   If the task was not waiting for a signal
+*                            OS_ERR_PEND_ABORT_SELF   If you attempted to pend abort the calling task.  This is not
+*                                                     possible since the calling task cannot be pending because it's
+*                                                     running.
+*
+* Returns    : == DEF_FALSE   if task was not waiting for a signal, or upon error.
+*              == DEF_TRUE    if task was waiting for a signal and was readied and informed.
+************************************************************************************************************************
+*/
+
+#if OS_CFG_TASK_SEM_PEND_ABORT_EN > 0u
+CPU_BOOLEAN  OSTaskSemPendAbort (OS_TCB  *p_tcb,
+                                 OS_OPT   opt,
+                                 OS_ERR  *p_err)
+{
+    CPU_BOOLEAN  rdy;
+    CPU_SR_ALLOC();
+    
+    /*Ƿж*/
+    if(rt_interrupt_get_nest()!=0)
+    {
+        *p_err = OS_ERR_PEND_ABORT_ISR;
+        return DEF_FALSE;
+    }
+    
+    if(opt != OS_OPT_POST_NONE && opt != OS_OPT_POST_NO_SCHED)
+    {
+        *p_err = OS_ERR_OPT_INVALID;
+        return DEF_FALSE;
+    }
+    
+    /*ֹԼĵȴ*/
+    if(p_tcb == RT_NULL || &p_tcb->Task == rt_thread_self())
+    {
+        *p_err = OS_ERR_PEND_ABORT_SELF;
+        return DEF_FALSE;
+    }
+    
+    CPU_CRITICAL_ENTER();
+    rdy = OS_TaskRdy(p_tcb, OS_TASK_PEND_ON_TASK_SEM, OS_STATUS_PEND_ABORT);
+    if(rdy == DEF_TRUE)
+    {
+        p_tcb->TS = OS_TS_GET();/*ֹȴʱ*/
+    }
+    CPU_CRITICAL_EXIT();
+    
+    if(rdy == DEF_FALSE)
+    {
+        *p_err = OS_ERR_PEND_ABORT_NONE;
+        return DEF_FALSE;
+    }
+    
+    if(opt != OS_OPT_POST_NO_SCHED)
+    {
+        OSSched();
+    }
+    
+    *p_err = OS_ERR_NONE;
+    return DEF_TRUE;
+}
+#endif
+
+/*
+************************************************************************************************************************
+*                                                    SIGNAL A TASK
+*
+* Description: This function is called to signal a task waiting for a signal.
+*
+* Arguments  : p_tcb     is the pointer to the TCB of the task to signal.  A NULL pointer indicates that you are sending
+*                        a signal to yourself.
+*
+*              opt       determines the type of POST performed:
+*
+*                             OS_OPT_POST_NONE         No option
+*                             OS_OPT_POST_NO_SCHED     Do not call the scheduler
+*
+*              p_err     is a pointer to an error code returned by this function:
+*
+*                            OS_ERR_NONE              If the requested task is signaled
+*                            OS_ERR_OPT_INVALID       if you specified an invalid option
+*                            OS_ERR_SEM_OVF           If the post would cause the semaphore count to overflow.
+*                            OS_ERR_INT_Q_FULL        If the post was deferred but the ISR queue is full (ӳٷʱ)
+*                            OS_ERR_TCB_INVALID       if the task was not created by OSTaskCreate()
+*
+* Returns    : The current value of the task's signal counter or 0 if called from an ISR
+*
+* Note(s)    : 1) ڵȴʱֻһ,ֵ;ֵ1.Ҫں˶,ҲҪȴб
+************************************************************************************************************************
+*/
+
+OS_SEM_CTR  OSTaskSemPost (OS_TCB  *p_tcb,
+                           OS_OPT   opt,
+                           OS_ERR  *p_err)
+{
+    OS_SEM_CTR  ctr;
+    CPU_TS      ts;
+    CPU_SR_ALLOC();
+    
+    ts = OS_TS_GET();/*Ͷݵʱ*/
+    
+    if(opt != OS_OPT_POST_NONE && opt != OS_OPT_POST_NO_SCHED)
+    {
+        *p_err = OS_ERR_OPT_INVALID;
+        return 0;
+    }
+    
+    /*TCBָΪNULL,ʾǰԼ*/
+    if(p_tcb == RT_NULL)
+    {
+        p_tcb = (OS_TCB *)rt_thread_self();
+    }
+    
+    /*ֻOSTaskCreate()OS_TCBչԱ*/
+    if(OS_TCB_GET(&p_tcb->Task) == RT_NULL)
+    {
+        *p_err = OS_ERR_TCB_INVALID;
+        return 0;
+    }
+    
+#if OS_CFG_ISR_POST_DEFERRED_EN > 0u
+    if(rt_interrupt_get_nest()!=0)/*жֻдж϶,ж϶дͶ*/
+    {
+        OS_IntQPost(OS_OBJ_TYPE_TASK_SIGNAL, (void *)p_tcb, RT_NULL, 0, 0, opt, p_err);
+        return 0;
+    }
+#endif
+    
+    CPU_CRITICAL_ENTER();
+    if(OS_TaskRdy(p_tcb, OS_TASK_PEND_ON_TASK_SEM, OS_STATUS_PEND_OK) == DEF_TRUE)/*ڵȴ,ֱӾ*/
+    {
+        p_tcb->TS = ts;
+        ctr = p_tcb->SemCtr;
+        CPU_CRITICAL_EXIT();
+        if(opt != OS_OPT_POST_NO_SCHED)
+        {
+            OSSched();
+        }
+        *p_err = OS_ERR_NONE;
+        return ctr;
+    }
+    
+    if(p_tcb->SemCtr == (OS_SEM_CTR)~(OS_SEM_CTR)0)
+    {
+        CPU_CRITICAL_EXIT();
+        *p_err = OS_ERR_SEM_OVF;
+        return 0;
+    }
+    p_tcb->SemCtr++;
+    p_tcb->TS = ts;
+    ctr = p_tcb->SemCtr;
+    CPU_CRITICAL_EXIT();
+    
+    *p_err = OS_ERR_NONE;
+    return ctr;
+}
+
+/*
+************************************************************************************************************************
+*                                            SET THE SIGNAL COUNTER OF A TASK
+*
+* Description: This function is called to clear the signal counter
+*
+* Arguments  : p_tcb      is the pointer to the task's OS_TCB to clear the counter.  If you specify a NULL pointer
+*                         then the signal counter of the current task will be cleared.
+*
+*              cnt        is the desired value of the semaphore counter
+*
+*              p_err      is a pointer to an error code returned by this function
+*
+*                             OS_ERR_NONE          if the signal counter of the requested task is cleared
+*                             OS_ERR_SET_ISR       if the function was called from an ISR
+*                             OS_ERR_TASK_WAITING  if the task is waiting for a signal
+*                             OS_ERR_TCB_INVALID   if the task was not created by OSTaskCreate()
+*
+* Returns    : the value of the signal counter before it was set
+************************************************************************************************************************
+*/
+
+OS_SEM_CTR  OSTaskSemSet (OS_TCB      *p_tcb,
+                          OS_SEM_CTR   cnt,
+                          OS_ERR      *p_err)
+{
+    OS_SEM_CTR  ctr;
+    CPU_SR_ALLOC();
+    
+    /*Ƿж*/
+    if(rt_interrupt_get_nest()!=0)
+    {
+        *p_err = OS_ERR_SET_ISR;
+        return 0;
+    }
+    
+    /*TCBָΪNULL,ʾǰ*/
+    if(p_tcb == RT_NULL)
+    {
+        p_tcb = (OS_TCB *)rt_thread_self();
+    }
+    
+    /*ֻOSTaskCreate()OS_TCBչԱ*/
+    if(OS_TCB_GET(&p_tcb->Task) == RT_NULL)
+    {
+        *p_err = OS_ERR_TCB_INVALID;
+        return 0;
+    }
+    
+    CPU_CRITICAL_ENTER();
+    ctr = p_tcb->SemCtr;
+    if(p_tcb->PendOn == OS_TASK_PEND_ON_TASK_SEM && cnt > 0)/*ڵȴʱֵΪ0,ƾ*/
+    {
+        CPU_CRITICAL_EXIT();
+        *p_err = OS_ERR_TASK_WAITING;
+        return ctr;
+    }
+    p_tcb->SemCtr = cnt;
+    CPU_CRITICAL_EXIT();
+    
+    *p_err = OS_ERR_NONE;
+    return ctr;
+}
+
+/*
+************************************************************************************************************************
+*                                                    STACK CHECKING
+*
+* Description: This function is called to calculate the amount of free memory left on the specified task's stack.
+*
+* Arguments  : p_tcb       is a pointer to the TCB of the task to check.  If you specify a NULL pointer then
+*                          you are specifying that you want to check the stack of the current task.
+*
+*              p_free      is a pointer to a variable that will receive the number of free 'entries' on the task's stack.
+*
+*              p_used      is a pointer to a variable that will receive the number of used 'entries' on the task's stack.
+*
+*              p_used_max  is a pointer to a variable that will receive the maximum number of used 'entries' on the task's stack.
+*
+*              p_err       is a pointer to a variable that will contain an error code.
+*
+*                              OS_ERR_NONE               upon success
+*                              OS_ERR_PTR_INVALID        if either 'p_free' or 'p_used' are NULL pointers
+*                              OS_ERR_TASK_NOT_EXIST     if the stack pointer of the task is a NULL pointer
+*                            - OS_ERR_TASK_OPT           if you did NOT specified OS_OPT_TASK_STK_CHK when the task
+*                                                        was created
+*                              OS_ERR_TASK_STK_CHK_ISR   you called this function from an ISR
+*                         -------------˵-------------
+*                             OS_ERR_XXXX        ʾԼuCOS-IIIԭĴ
+*                           - OS_ERR_XXXX        ʾôڱݲѾ޷ʹ
+*                           + OS_ERR_RT_XXXX     ʾôΪRTTרô뼯
+*                          ӦòҪAPIصĴжӦ޸
+* Returns    : none
+*
+* Note(s)    : 1) ԭ溯ȡʵʱջʹ,ڱݲиúȡĽֹǰʱ̵Ķջʹúʵʱʹ/ʣ,
+*                 ԭ溯һp_used_max,ҪԭЧǰ(߳)Ķջʹ
+*              2) ʹļOS_TaskStkUsedMax()
+************************************************************************************************************************
+*/
+
+void  OSTaskStkChk (OS_TCB        *p_tcb,
+                    CPU_STK_SIZE  *p_free,
+                    CPU_STK_SIZE  *p_used,
+                    CPU_STK_SIZE  *p_used_max,
+                    OS_ERR        *p_err)
+{
+    rt_uint32_t stack_size;
+    rt_uint32_t stack_used_max;
+    rt_uint32_t stack_used;
+    rt_uint32_t stack_free;
+    rt_thread_t thread;
+    
+    if(p_free == RT_NULL ||
+       p_used == RT_NULL
+    )
+    {
+        *p_err = OS_ERR_PTR_INVALID;
+        return;
+    }
+        
+    /*Ƿж*/
+    if(rt_interrupt_get_nest()!=0)
+    {
+        *p_err = OS_ERR_TASK_STK_CHK_ISR;
+        return;
+    }   
+    
+    /*TCBָΪNULL,ʾǰ߳*/
+    if(p_tcb ==RT_NULL)
+    {
+        thread = rt_thread_self();
+    }
+    else
+    {
+        thread = &p_tcb->Task;
+    }
+    
+    /*ջǷΪNULL*/
+    if(thread->stack_addr == RT_NULL)
+    {
+        *p_err = OS_ERR_TASK_NOT_EXIST;
+        return;        
+    }
+    
+    *p_err = OS_ERR_NONE;
+    
+    /*ջʹ*/
+    stack_size = thread->stack_size;
+    stack_used_max = OS_TaskStkUsedMax(thread);
+    
+    /*ջʵʱʹ*/
+    stack_used = (rt_ubase_t)thread->stack_addr + thread->stack_size - (rt_ubase_t)thread->sp;
+    stack_free = stack_size - stack_used;
+    
+    *p_used_max = stack_used_max / sizeof(CPU_STK_SIZE);
+    *p_used = stack_used / sizeof(CPU_STK_SIZE);
+    *p_free = stack_free / sizeof(CPU_STK_SIZE);
+}
+
+/*
+************************************************************************************************************************
+*                                               STACK CHECKING OF ALL TASKS
+*
+* Description: This function is called to calculate the stack usage of every task in one pass, e.g. for a periodic
+*              health report.
+*
+* Arguments  : p_info_tbl  is a pointer to a table that will receive one OS_STK_INFO per task
+*
+*              nbr_max     is the number of entries of 'p_info_tbl'
+*
+*              p_err       is a pointer to a variable that will contain an error code.
+*
+*                              OS_ERR_NONE               upon success
+*                              OS_ERR_PTR_INVALID        if 'p_info_tbl' is a NULL pointer
+*                              OS_ERR_TASK_STK_CHK_ISR   you called this function from an ISR
+*
+* Returns    : The number of entries written to 'p_info_tbl'.  If there are more than 'nbr_max' tasks, only the first
+*              'nbr_max' tasks are reported.
+*
+* Note(s)    : 1) RTT߳,RTTԭ߳;ڼֹ̱߳ɾ,ж
+************************************************************************************************************************
+*/
+
+OS_OBJ_QTY  OSTaskStkChkAll (OS_STK_INFO  *p_info_tbl,
+                             OS_OBJ_QTY    nbr_max,
+                             OS_ERR       *p_err)
+{
+    struct rt_object_information  *p_info;
+    rt_list_t                     *p_node;
+    rt_thread_t                    thread;
+    OS_OBJ_QTY                     nbr;
+    rt_uint32_t                    stack_used;
+    
+    if(p_info_tbl == RT_NULL)
+    {
+        *p_err = OS_ERR_PTR_INVALID;
+        return 0;
+    }
+    
+    /*Ƿж*/
+    if(rt_interrupt_get_nest()!=0)
+    {
+        *p_err = OS_ERR_TASK_STK_CHK_ISR;
+        return 0;
+    }
+    
+    nbr = 0;
+    rt_enter_critical();
+    p_info = rt_object_get_information(RT_Object_Class_Thread);
+    for(p_node  = p_info->object_list.next;
+        p_node != &p_info->object_list && nbr < nbr_max;
+        p_node  = p_node->next)
+    {
+        thread = (rt_thread_t)rt_list_entry(p_node, struct rt_object, list);
+        stack_used = (rt_ubase_t)thread->stack_addr + thread->stack_size - (rt_ubase_t)thread->sp;
+        
+        p_info_tbl[nbr].TaskPtr = thread;
+        p_info_tbl[nbr].UsedMax = OS_TaskStkUsedMax(thread) / sizeof(CPU_STK_SIZE);
+        p_info_tbl[nbr].Used    = stack_used / sizeof(CPU_STK_SIZE);
+        p_info_tbl[nbr].Free    = (thread->stack_size - stack_used) / sizeof(CPU_STK_SIZE);
+        nbr++;
+    }
+    rt_exit_critical();
+    
+    *p_err = OS_ERR_NONE;
+    return nbr;
+}
+
+/*
+************************************************************************************************************************
+*                                           FIND THE STACK HIGH-WATER MARK
+*
+* Description: This function is called to find the maximum number of bytes ever used on the stack of a task.
+*
+* Arguments  : thread     is a pointer to the task to check
+*
+* Returns    : The maximum number of bytes used on the stack
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) RTT߳ʱջ'#',Ӷջײ(͵ַ)ҵһдֽڼΪʷλ.
+*                 ֱַȽ,ֻڵһдֽڱȽ
+*              3) OSTaskCreate()¼һҵλ(StkMarkPtr),ֻ֮λµ,
+*                 λֻƶ,ѾùĶջмʹǡó'#'ҲʹС
+************************************************************************************************************************
+*/
+
+#define  OS_STK_FILL_WORD       ((rt_ubase_t)~(rt_ubase_t)0 / 0xFFu * (rt_ubase_t)'#')   /* ÿֽڶΪ'#' */
+
+static  rt_uint32_t  OS_TaskStkUsedMax (rt_thread_t  thread)
+{
+    OS_TCB      *p_tcb;
+    CPU_INT08U  *ptr;
+    CPU_INT08U  *mark;
+    CPU_SR_ALLOC();
+    
+    p_tcb = OS_TCB_GET(thread);
+    if(p_tcb != RT_NULL)
+    {
+        mark = p_tcb->StkMarkPtr;
+    }
+    else
+    {
+        mark = (CPU_INT08U *)thread->stack_addr + thread->stack_size;
+    }
+    
+    ptr = (CPU_INT08U *)thread->stack_addr;
+    /*ʼַδĲֽڱȽ*/
+    while(ptr < mark && ((rt_ubase_t)ptr & (sizeof(rt_ubase_t) - 1u)) != 0u && *ptr == '#')
+    {
+        ptr++;
+    }
+    /*ֱȽ*/
+    if(((rt_ubase_t)ptr & (sizeof(rt_ubase_t) - 1u)) == 0u)
+    {
+        while(ptr + sizeof(rt_ubase_t) <= mark && *(rt_ubase_t *)ptr == OS_STK_FILL_WORD)
+        {
+            ptr += sizeof(rt_ubase_t);
+        }
+    }
+    /*һдֽڱȽ*/
+    while(ptr < mark && *ptr == '#')
+    {
+        ptr++;
+    }
+    
+    if(p_tcb != RT_NULL)
+    {
+        CPU_CRITICAL_ENTER();
+        if(ptr < p_tcb->StkMarkPtr)/*ͬʱ¹*/
+        {
+            p_tcb->StkMarkPtr = ptr;
+        }
+        CPU_CRITICAL_EXIT();
+    }
+    
+    return (rt_uint32_t)((CPU_INT08U *)thread->stack_addr + thread->stack_size - ptr);
+}
+
+/*
+************************************************************************************************************************
+*                                                   SUSPEND A TASK
+*
+* Description: This function is called to suspend a task.  The task can be the calling task if 'p_tcb' is a NULL pointer
+*              or the pointer to the TCB of the calling task.
+*
+* Arguments  : p_tcb    is a pointer to the TCB to suspend.
+*                       If p_tcb is a NULL pointer then, suspend the current task.
+*
+*              p_err    is a pointer to a variable that will receive an error code from this function.
+*
+*                           OS_ERR_NONE                      if the requested task is suspended
+*                           OS_ERR_SCHED_LOCKED              you can't suspend the current task is the scheduler is
+*                                                            locked
+*                           OS_ERR_TASK_SUSPEND_ISR          if you called this function from an ISR
+*                         - OS_ERR_TASK_SUSPEND_IDLE         if you attempted to suspend the idle task which is not
+*                                                            allowed.
+*                         - OS_ERR_TASK_SUSPEND_INT_HANDLER  if you attempted to suspend the idle task which is not
+*                                                            allowed.
+*                       -------------˵-------------
+*                           OS_ERR_XXXX        ʾԼuCOS-IIIԭĴ
+*                         - OS_ERR_XXXX        ʾôڱݲѾ޷ʹ
+*                         + OS_ERR_RT_XXXX     ʾôΪRTTרô뼯
+*                        ӦòҪAPIصĴжӦ޸
+*
+* Note(s)    : 1) You should use this function with great care.  If you suspend a task that is waiting for an event
+*                 (i.e. a message, a semaphore, a queue ...) you will prevent this task from running when the event
+*                 arrives.
+*              2) uCOS-III֧Ƕ׹/,5,5,񼴿
+*                 RTT֧Ƕ׹/,˸ú޷ʵǶ׹
+*              3) OSTimeDly()ʱʱ,ֻΪOS_TASK_STATE_DLY_SUSPENDED,
+*                 ʱںֹ,ֱOSTaskResume()
+************************************************************************************************************************
+*/
+
+void   OSTaskSuspend (OS_TCB  *p_tcb,
+                      OS_ERR  *p_err)
+{
+    rt_err_t rt_err;
+    OS_TCB  *p_os_tcb;
+    CPU_SR_ALLOC();
+    
+    /*Ƿж*/
+    if(rt_interrupt_get_nest()!=0)
+    {
+        *p_err = OS_ERR_TASK_SUSPEND_ISR;
+        return;
+    }
+
+    /*Ƿ*/
+    if(rt_critical_level() > 0)
+    {
+        *p_err = OS_ERR_SCHED_LOCKED;
+        return;         
+    }
+
+    /*TCBָǷΪ,Ϊձʾǰ߳*/
+    if(p_tcb == RT_NULL)
+    {
+        p_tcb = (OS_TCB *)rt_thread_self();
+    }
+    p_os_tcb = OS_TCB_GET(&p_tcb->Task);/*ֻOSTaskCreate()ż¼ʱ/״̬*/
+    
+    CPU_CRITICAL_ENTER();
+    if(p_os_tcb != RT_NULL && p_os_tcb->TaskState == OS_TASK_STATE_DLY)
+    {
+        /*̶߳ʱʱ,ʱںOSTimeDly()Լٹ*/
+        p_os_tcb->TaskState = OS_TASK_STATE_DLY_SUSPENDED;
+        CPU_CRITICAL_EXIT();
+        *p_err = OS_ERR_NONE;
+        return;
+    }
+    rt_err = rt_thread_suspend(&p_tcb->Task);
+    if(rt_err == RT_EOK && p_os_tcb != RT_NULL)
+    {
+        p_os_tcb->TaskState = OS_TASK_STATE_SUSPENDED;
+    }
+    CPU_CRITICAL_EXIT();
+    
+    if(rt_thread_self() == &p_tcb->Task)/*ǷҪԼ*/
+    {
+        rt_schedule();/* RTTҪ,ԼҪrt_sheduleе*/
+    }
+        
+    *p_err = _err_rtt_to_ucosiii(rt_err);
 }
 
 /*
@@ -584,8 +1891,12 @@ void   OSTaskSuspend (OS_TCB  *p_tcb,
 *
 *                               OS_ERR_NONE       upon success
 *                               OS_ERR_SET_ISR    if you called this function from an ISR
+*                               OS_ERR_TCB_INVALID if the task was not created by OSTaskCreate()
 *
 * Returns    : none
+*
+* Note(s)    : 1) ֻ޸RTT̵߳init_tick,ǰʱƬӰ,һʱƬʼЧ
+*              2) time_quantaΪ0ʾʹOSSchedRoundRobinCfg()õĬϳ
 ************************************************************************************************************************
 */
 
@@ -593,4 +1904,73 @@ void  OSTaskTimeQuantaSet (OS_TCB   *p_tcb,
                            OS_TICK   time_quanta,
                            OS_ERR   *p_err)
 {
+    CPU_SR_ALLOC();
+    
+    /*Ƿж*/
+    if(rt_interrupt_get_nest()!=0)
+    {
+        *p_err = OS_ERR_SET_ISR;
+        return;
+    }
+    
+    /*TCBָΪNULL,ʾǰ*/
+    if(p_tcb == RT_NULL)
+    {
+        p_tcb = (OS_TCB *)rt_thread_self();
+    }
+    
+    /*ֻOSTaskCreate()OS_TCBչԱ*/
+    if(OS_TCB_GET(&p_tcb->Task) == RT_NULL)
+    {
+        *p_err = OS_ERR_TCB_INVALID;
+        return;
+    }
+    
+    CPU_CRITICAL_ENTER();
+    p_tcb->TimeQuanta = time_quanta;
+    p_tcb->Task.init_tick = OS_SchedRoundRobinQuanta(time_quanta);
+    CPU_CRITICAL_EXIT();
+    
+    *p_err = OS_ERR_NONE;
+}
+
+/*
+************************************************************************************************************************
+*                                          ENTRY POINT OF TASKS CREATED BY OSTaskCreate()
+*
+* Description: This function is the RT-Thread entry point of every task created by OSTaskCreate().  It calls the task
+*              function and, if the task function returns, releases what OSTaskDel() would have released before
+*              RT-Thread terminates the thread.
+*
+* Arguments  : p_arg      is a pointer to the OS_TCB of the task
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) ൱uCOS-IIIOS_TaskReturn():غ,RTTrt_thread_exit()̶ֱ߳,
+*                 ᾭOSTaskDel(),ڷRTT֮ǰ黹ڽϢеϢTLS
+*              3) ʹ̵߳cleanupص:cleanupľ̬߳Ҫȵ̴߳,
+*                 ڴ֮ǰͬһOS_TCBٴεOSTaskCreate()ظʼʹõ̶߳
+************************************************************************************************************************
+*/
+
+static  void  OS_TaskEntry (void  *p_arg)
+{
+    OS_TCB  *p_tcb;
+#if OS_CFG_TASK_Q_EN > 0u
+    CPU_SR_ALLOC();
+#endif
+
+
+    p_tcb = (OS_TCB *)p_arg;
+    p_tcb->TaskEntryAddr(p_tcb->TaskEntryArg);
+
+#if OS_CFG_TLS_TBL_SIZE > 0u
+    OS_TLS_TaskDel(p_tcb);/*øTLS*/
+#endif
+#if OS_CFG_TASK_Q_EN > 0u
+    CPU_CRITICAL_ENTER();
+    (void)OS_MsgQFreeAll(&p_tcb->MsgQ);
+    CPU_CRITICAL_EXIT();
+#endif
 }
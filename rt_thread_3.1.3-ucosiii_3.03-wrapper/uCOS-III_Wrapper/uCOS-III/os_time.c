@@ -42,10 +42,9 @@
 
 #include <os.h>
 
-/*
-RTTûؽӿڣºûʵ
-OSTimeDlyResume
-*/
+static  CPU_BOOLEAN  OS_TimeDly (OS_TICK   dly,
+                                 OS_OPT    opt,
+                                 OS_ERR   *p_err);
 
 /*
 ************************************************************************************************************************
@@ -75,8 +74,9 @@ OSTimeDlyResume
 *                            OS_OPT_TIME_PERIODIC   indicates that 'dly' specifies the periodic value that OSTickCtr
 *                                                   must reach before the task will be resumed.
 *                            -------------˵-------------
-*                             RTTûʵع,OS_OPT_TIME_DLY/OS_OPT_TIME_TIMEOUT/OS_OPT_TIME_MATCHڼݲ޷ʹ
-*                             ӦòҪAPIصĴжӦ޸
+*                             OS_OPT_TIME_PERIODICһεĻʱ(TickCtrPrev)Ϊ׼,ִʱ䲻ۻƯ;
+*                             һʱ(һεþ񴴽ѳdly)Եǰʱ¿ʼ.
+*                             ֻOSTaskCreate()TickCtrPrev,߳ʹOS_OPT_TIME_PERIODICʱ˻Ϊʱ
 *
 *              p_err     is a pointer to a variable that will contain an error code from this call.
 *
@@ -84,7 +84,8 @@ OSTimeDlyResume
 *                            OS_ERR_OPT_INVALID     if you specified an invalid option for this function.
 *                            OS_ERR_SCHED_LOCKED    can't delay when the scheduler is locked.
 *                            OS_ERR_TIME_DLY_ISR    if you called this function from an ISR.
-*                            OS_ERR_TIME_ZERO_DLY   if you specified a delay of zero.
+*                            OS_ERR_TIME_ZERO_DLY   if you specified a delay of zero, or the absolute tick (MATCH) or the
+*                                                   next period (PERIODIC) has already been reached.
 *                        -------------˵-------------
 *                            OS_ERR_XXXX        ʾԼuCOS-IIIԭĴ
 *                          - OS_ERR_XXXX        ʾôڱݲѾ޷ʹ
@@ -99,42 +100,7 @@ void  OSTimeDly (OS_TICK   dly,
                  OS_OPT    opt,
                  OS_ERR   *p_err)
 {
-    rt_err_t rt_err;
-    
-    /*Ƿж*/
-    if(rt_interrupt_get_nest()!=0)
-    {
-        *p_err = OS_ERR_TIME_DLY_ISR;
-        return; 
-    }
-    
-    /*Ƿ*/
-    if(rt_critical_level() > 0)
-    {
-        *p_err = OS_ERR_SCHED_LOCKED;
-        return;         
-    }   
-    
-    /*ǷΪ0ʱ*/
-    if(dly == 0)
-    {
-        *p_err = OS_ERR_TIME_ZERO_DLY;
-        return;         
-    }
-    
-    /*opts*/
-    if(opt == OS_OPT_TIME_DLY || 
-       opt == OS_OPT_TIME_MATCH ||
-       opt == OS_OPT_TIME_TIMEOUT)
-    {
-        /*opts޷ʵ*/
-        *p_err = OS_ERR_OPT_INVALID;
-        RT_DEBUG_LOG(RT_DEBUG_UCOSIII,("OSTimeDly: wrapper can't accept this option\r\n"));
-        return;
-    }
-    
-    rt_err = rt_thread_delay(dly);
-    *p_err = _err_rtt_to_ucosiii(rt_err); 
+    (void)OS_TimeDly(dly, opt, p_err);
 }
 
 /*
@@ -171,7 +137,10 @@ void  OSTimeDly (OS_TICK   dly,
 *                                                                                   seconds      (0...65535)
 *                                                                                   milliseconds (0...4294967295)
 *                         -------------˵-------------
-*                         optsΪOS_OPT_TIME_HMSM_NON_STRICT|OS_OPT_TIME_PERIODIC   
+*                         ʱֱӻΪtick(64λ,),ʱѡĺOSTimeDly()ͬ;
+*                         OS_OPT_TIME_DLY/OS_OPT_TIME_TIMEOUTʱRTTζʱ(OS_TIME_DLY_MAX)ʱ,
+*                         ֳɶȴ,ֻһνʱ;
+*                         OS_OPT_TIME_MATCH/OS_OPT_TIME_PERIODICܳOS_TIME_DLY_MAX
 *
 *              p_err     is a pointer to a variable that will receive an error code from this call.
 *
@@ -180,6 +149,7 @@ void  OSTimeDly (OS_TICK   dly,
 *                            OS_ERR_SCHED_LOCKED                Can't delay when the scheduler is locked
 *                            OS_ERR_TIME_DLY_ISR                If called from an ISR
 *                            OS_ERR_TIME_INVALID_HOURS          If you didn't specify a valid value for 'hours'
+*                                                               (MATCH/PERIODICʱ䳬OS_TIME_DLY_MAX)
 *                            OS_ERR_TIME_INVALID_MINUTES        If you didn't specify a valid value for 'minutes'
 *                            OS_ERR_TIME_INVALID_SECONDS        If you didn't specify a valid value for 'seconds'
 *                            OS_ERR_TIME_INVALID_MILLISECONDS   If you didn't specify a valid value for 'milli'
@@ -206,8 +176,8 @@ void  OSTimeDlyHMSM (CPU_INT16U   hours,
                      OS_OPT       opt,
                      OS_ERR      *p_err)
 {
-    rt_err_t rt_err;
-    rt_int32_t dly;
+    CPU_INT64U  ticks;
+    OS_OPT      opt_time;
     
 #if OS_CFG_ARG_CHK_EN > 0u     
     CPU_BOOLEAN  opt_invalid;
@@ -263,19 +233,38 @@ void  OSTimeDlyHMSM (CPU_INT16U   hours,
     }
 #endif
     
-    dly = hours*3600*1000+minutes*60*1000+seconds*1000+milli;
+    /*ֱӻΪtick,벿뵽tick*/
+    ticks = ((CPU_INT64U)hours * 3600u + (CPU_INT64U)minutes * 60u + (CPU_INT64U)seconds) * RT_TICK_PER_SECOND
+          + ((CPU_INT64U)milli * RT_TICK_PER_SECOND + 500u) / 1000u;
     
-#if OS_CFG_ARG_CHK_EN > 0u     
     /*ǷΪ0ʱ*/
-    if(dly == 0)
+    if(ticks == 0)
     {
         *p_err = OS_ERR_TIME_ZERO_DLY;
         return;         
     }
-#endif
     
-    rt_err = rt_thread_mdelay(dly);   
-    *p_err = _err_rtt_to_ucosiii(rt_err);
+    opt_time = opt & OS_OPT_TIME_MASK;
+    if(opt_time == OS_OPT_TIME_MATCH || opt_time == OS_OPT_TIME_PERIODIC)
+    {
+        if(ticks > OS_TIME_DLY_MAX)/*ʱ̺޷ֶεȴ*/
+        {
+            *p_err = OS_ERR_TIME_INVALID_HOURS;
+            return;
+        }
+        OSTimeDly((OS_TICK)ticks, opt_time, p_err);
+        return;
+    }
+    
+    while(ticks > OS_TIME_DLY_MAX)/*ζʱ,ֶεȴ*/
+    {
+        if(OS_TimeDly(OS_TIME_DLY_MAX, OS_OPT_TIME_DLY, p_err) == DEF_FALSE)/*OSTimeDlyResume()ǰ*/
+        {
+            return;
+        }
+        ticks -= OS_TIME_DLY_MAX;
+    }
+    (void)OS_TimeDly((OS_TICK)ticks, OS_OPT_TIME_DLY, p_err);
 }
 
 /*
@@ -291,19 +280,64 @@ void  OSTimeDlyHMSM (CPU_INT16U   hours,
 *              p_err    is a pointer to a variable that will receive an error code
 *
 *                           OS_ERR_NONE                  Task has been resumed
-*                           OS_ERR_STATE_INVALID         Task is in an invalid state
+*                         - OS_ERR_STATE_INVALID         Task is in an invalid state
 *                           OS_ERR_TIME_DLY_RESUME_ISR   If called from an ISR
-*                           OS_ERR_TIME_NOT_DLY          Task is not waiting for time to expire
+*                           OS_ERR_TASK_NOT_DLY          Task is not waiting for time to expire
 *                           OS_ERR_TASK_SUSPENDED        Task cannot be resumed, it was suspended by OSTaskSuspend()
-*
-* Note(s)    : none
+*                       -------------˵-------------
+*                           OS_ERR_XXXX        ʾԼuCOS-IIIԭĴ
+*                         - OS_ERR_XXXX        ʾôڱݲѾ޷ʹ
+*                         + OS_ERR_RT_XXXX     ʾôΪRTTרô뼯
+*
+* Note(s)    : 1) ֻOSTaskCreate(),ȴں˶(ʱ)񲻴ʱ״̬,OS_ERR_TASK_NOT_DLY
+*              2) ʱڼֱOSTaskSuspend(),ʱȡԱֹ,OS_ERR_TASK_SUSPENDED
+*              3) ǰѵOSTimeDlyHMSM()ټʣķֶεȴ
 ************************************************************************************************************************
 */
-/*RTTûʵָýӿ*/
-//void  OSTimeDlyResume (OS_TCB  *p_tcb,
-//                       OS_ERR  *p_err)
-//{
-//}
+
+void  OSTimeDlyResume (OS_TCB  *p_tcb,
+                       OS_ERR  *p_err)
+{
+    CPU_SR_ALLOC();
+    
+    /*Ƿж*/
+    if(rt_interrupt_get_nest()!=0)
+    {
+        *p_err = OS_ERR_TIME_DLY_RESUME_ISR;
+        return;
+    }
+    
+    /*ܻԼ(Լ,Ȼûʱ)*/
+    if(p_tcb == RT_NULL || &p_tcb->Task == rt_thread_self() || OS_TCB_GET(&p_tcb->Task) == RT_NULL)
+    {
+        *p_err = OS_ERR_TASK_NOT_DLY;
+        return;
+    }
+    
+    CPU_CRITICAL_ENTER();
+    switch(p_tcb->TaskState)
+    {
+        case OS_TASK_STATE_DLY:
+            p_tcb->TaskState = OS_TASK_STATE_RDY;
+            rt_thread_resume(&p_tcb->Task);/*ͬʱ̶ֹͣ߳ʱ*/
+            CPU_CRITICAL_EXIT();
+            OSSched();
+            *p_err = OS_ERR_NONE;
+            break;
+            
+        case OS_TASK_STATE_DLY_SUSPENDED:
+            p_tcb->TaskState = OS_TASK_STATE_SUSPENDED;
+            rt_timer_stop(&(p_tcb->Task.thread_timer));/*ֻȡʱ,Աֹ*/
+            CPU_CRITICAL_EXIT();
+            *p_err = OS_ERR_TASK_SUSPENDED;
+            break;
+            
+        default:
+            CPU_CRITICAL_EXIT();
+            *p_err = OS_ERR_TASK_NOT_DLY;
+            break;
+    }
+}
 
 /*
 ************************************************************************************************************************
@@ -366,3 +400,143 @@ void  OSTimeTick (void)
 {
     rt_tick_increase();
 }
+
+/*
+************************************************************************************************************************
+*                                                  DELAY THE CURRENT TASK
+*
+* Description: This function implements OSTimeDly() and the delays of OSTimeDlyHMSM().
+*
+* Arguments  : dly       see OSTimeDly()
+*
+*              opt       see OSTimeDly()
+*
+*              p_err     see OSTimeDly()
+*
+* Returns    : DEF_TRUE   if the delay expired
+*              DEF_FALSE  if the task did not delay or the delay was cancelled by OSTimeDlyResume()
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+*              2) OSTaskCreate()ʱڼTaskStateΪOS_TASK_STATE_DLY(OS_TASK_STATE_DLY_SUSPENDED),
+*                 OSTimeDlyResume()OSTaskSuspend()/OSTaskResume()ݴʱ
+************************************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  OS_TimeDly (OS_TICK   dly,
+                                 OS_OPT    opt,
+                                 OS_ERR   *p_err)
+{
+    rt_thread_t  thread;
+    OS_TCB      *p_tcb;
+    OS_TICK      tick;
+    OS_TICK      remain;
+    CPU_BOOLEAN  timeout;
+    CPU_SR_ALLOC();
+    
+    /*Ƿж*/
+    if(rt_interrupt_get_nest()!=0)
+    {
+        *p_err = OS_ERR_TIME_DLY_ISR;
+        return DEF_FALSE;
+    }
+    
+    /*Ƿ*/
+    if(rt_critical_level() > 0)
+    {
+        *p_err = OS_ERR_SCHED_LOCKED;
+        return DEF_FALSE;
+    }   
+    
+    /*opts*/
+    switch(opt)
+    {
+        case OS_OPT_TIME_DLY:
+        case OS_OPT_TIME_TIMEOUT:
+        case OS_OPT_TIME_PERIODIC:
+            if(dly == 0)/*ǷΪ0ʱ*/
+            {
+                *p_err = OS_ERR_TIME_ZERO_DLY;
+                return DEF_FALSE;
+            }
+            break;
+            
+        case OS_OPT_TIME_MATCH:
+            break;
+            
+        default:
+            *p_err = OS_ERR_OPT_INVALID;
+            return DEF_FALSE;
+    }
+    
+    thread = rt_thread_self();
+    p_tcb  = OS_TCB_GET(thread);
+    
+    /*ڹжϵ״̬¶ȡtick̶߳ʱ,֮䲻©tick*/
+    CPU_CRITICAL_ENTER();
+    tick = rt_tick_get();
+    if(opt == OS_OPT_TIME_MATCH)
+    {
+        remain = dly - tick;
+        if(remain == 0 || remain >= RT_TICK_MAX / 2)/*ʱѵѹ*/
+        {
+            CPU_CRITICAL_EXIT();
+            *p_err = OS_ERR_TIME_ZERO_DLY;
+            return DEF_FALSE;
+        }
+    }
+    else if(opt == OS_OPT_TIME_PERIODIC && p_tcb != RT_NULL)
+    {
+        if(tick - p_tcb->TickCtrPrev > dly)/*,ӵǰʱ¿ʼ*/
+        {
+            remain = dly;
+            p_tcb->TickCtrPrev = tick + dly;
+        }
+        else
+        {
+            remain = dly - (tick - p_tcb->TickCtrPrev);
+            p_tcb->TickCtrPrev += dly;
+            if(remain == 0)/*ڵĻʱǡѵ*/
+            {
+                CPU_CRITICAL_EXIT();
+                *p_err = OS_ERR_TIME_ZERO_DLY;
+                return DEF_FALSE;
+            }
+        }
+    }
+    else
+    {
+        remain = dly;
+    }
+    
+    if(p_tcb != RT_NULL)
+    {
+        p_tcb->TaskState = OS_TASK_STATE_DLY;
+    }
+    thread->error = RT_EOK;
+    rt_thread_suspend(thread);
+    rt_timer_control(&(thread->thread_timer), RT_TIMER_CTRL_SET_TIME, &remain);
+    rt_timer_start(&(thread->thread_timer));
+    CPU_CRITICAL_EXIT();
+    
+    rt_schedule();
+    
+    CPU_CRITICAL_ENTER();
+    timeout = (thread->error == -RT_ETIMEOUT) ? DEF_TRUE : DEF_FALSE;/*ǱOSTimeDlyResume()ǰѵ*/
+    thread->error = RT_EOK;
+    if(p_tcb != RT_NULL)
+    {
+        if(p_tcb->TaskState == OS_TASK_STATE_DLY_SUSPENDED)/*ʱڼ䱻OSTaskSuspend(),ʱ*/
+        {
+            p_tcb->TaskState = OS_TASK_STATE_SUSPENDED;
+            rt_thread_suspend(thread);
+            CPU_CRITICAL_EXIT();
+            rt_schedule();/*ֱOSTaskResume()*/
+            CPU_CRITICAL_ENTER();
+        }
+        p_tcb->TaskState = OS_TASK_STATE_RDY;
+    }
+    CPU_CRITICAL_EXIT();
+    
+    *p_err = OS_ERR_NONE;
+    return timeout;
+}
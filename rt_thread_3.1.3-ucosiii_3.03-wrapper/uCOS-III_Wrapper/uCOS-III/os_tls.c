@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2020-07-20     Meco Man     the first verion
+ */
+
+/*
+************************************************************************************************************************
+*                                                      uC/OS-III
+*                                                 The Real-Time Kernel
+*
+*                                  (c) Copyright 2009-2012; Micrium, Inc.; Weston, FL
+*                           All rights reserved.  Protected by international copyright laws.
+*
+*                                            THREAD LOCAL STORAGE (TLS) MANAGEMENT
+*
+* File    : OS_TLS.C
+* By      : JJL
+* Version : V3.03.00
+*
+* LICENSING TERMS:
+* ---------------
+*           uC/OS-III is provided in source form for FREE short-term evaluation, for educational use or 
+*           for peaceful research.  If you plan or intend to use uC/OS-III in a commercial application/
+*           product then, you need to contact Micrium to properly license uC/OS-III for its use in your 
+*           application/product.   We provide ALL the source code for your convenience and to help you 
+*           experience uC/OS-III.  The fact that the source is provided does NOT mean that you can use 
+*           it commercially without paying a licensing fee.
+*
+*           Knowledge of the source code may NOT be used to develop a similar product.
+*
+*           Please help us continue to provide the embedded community with the finest software available.
+*           Your honesty is greatly appreciated.
+*
+*           You can contact us at www.micrium.com, or by phone at +1 (954) 217-2036.
+************************************************************************************************************************
+*/
+
+#include <os.h>
+
+/*
+TLS˵:
+    ÿOS_CFG_TLS_TBL_SIZEOS_TLS,۱OS_TCB,OSTaskCreate()ջĵײ(͵ַ)
+    OS_TLS_STK_SIZECPU_STK,ʣಿֲŽRTTΪ̶߳ջ,stk_sizeҪⲿּ;
+    OS_OPT_TASK_NO_TLS񲻻۱(TLS_TblΪNULL),ջȫʹ,TLSOS_ERR_TLS_NOT_EN
+    OSTaskDel()е,ϷʱҲOS_TaskEntry()
+*/
+
+#if OS_CFG_TLS_TBL_SIZE > 0u
+
+static  OS_TLS_ID            OS_TLS_NextAvailID;            /* Next available TLS ID                                  */
+static  OS_TLS_DESTRUCT_PTR  OS_TLS_DestructPtrTbl[OS_CFG_TLS_TBL_SIZE];
+
+/*
+************************************************************************************************************************
+*                                       ALLOCATE THE NEXT AVAILABLE TLS ID
+*
+* Description: This function is called to obtain the ID of the next free TLS (Task Local Storage) register 'id'
+*
+* Arguments  : p_err       is a pointer to a variable that will hold an error code related to this call.
+*
+*                            OS_ERR_NONE               if the call was successful
+*                            OS_ERR_TLS_NO_MORE_AVAIL  if you are attempting to assign more TLS than you declared
+*                                                           available through OS_CFG_TLS_TBL_SIZE.
+*
+* Returns    : The next available TLS 'id' or OS_CFG_TLS_TBL_SIZE if an error is detected.
+************************************************************************************************************************
+*/
+
+OS_TLS_ID  OS_TLS_GetID (OS_ERR  *p_err)
+{
+    OS_TLS_ID  id;
+    CPU_SR_ALLOC();
+    
+    CPU_CRITICAL_ENTER();
+    if(OS_TLS_NextAvailID >= OS_CFG_TLS_TBL_SIZE)/*IDѷ*/
+    {
+        CPU_CRITICAL_EXIT();
+        *p_err = OS_ERR_TLS_NO_MORE_AVAIL;
+        return (OS_TLS_ID)OS_CFG_TLS_TBL_SIZE;
+    }
+    id = OS_TLS_NextAvailID;
+    OS_TLS_NextAvailID++;
+    CPU_CRITICAL_EXIT();
+    
+    *p_err = OS_ERR_NONE;
+    return id;
+}
+
+/*
+************************************************************************************************************************
+*                                        GET THE CURRENT VALUE OF A TLS REGISTER
+*
+* Description: This function is called to obtain the current value of a TLS register
+*
+* Arguments  : p_tcb     is a pointer to the OS_TCB of the task you want to read the TLS register from.  If 'p_tcb' is
+*                        a NULL pointer then you will get the TLS register of the current task.
+*
+*              id        is the 'id' of the desired TLS register.  Note that the 'id' must be less than
+*                        'OS_TLS_NextAvailID'
+*
+*              p_err     is a pointer to a variable that will hold an error code related to this call.
+*
+*                            OS_ERR_NONE            if the call was successful
+*                            OS_ERR_TLS_ID_INVALID  if the 'id' is greater or equal to OS_TLS_NextAvailID
+*                            OS_ERR_TLS_NOT_EN      if the task was created by specifying that TLS support was not
+*                                                     needed for the task
+*                            OS_ERR_TCB_INVALID     if the task was not created by OSTaskCreate()
+*
+* Returns    : The current value of the task's TLS register or 0 if an error is detected.
+************************************************************************************************************************
+*/
+
+OS_TLS  OS_TLS_GetValue (OS_TCB     *p_tcb,
+                         OS_TLS_ID   id,
+                         OS_ERR     *p_err)
+{
+    OS_TLS  value;
+    CPU_SR_ALLOC();
+    
+    if(id >= OS_TLS_NextAvailID)/*IDδ*/
+    {
+        *p_err = OS_ERR_TLS_ID_INVALID;
+        return (OS_TLS)0;
+    }
+    
+    /*TCBָΪNULL,ʾǰ*/
+    if(p_tcb == RT_NULL)
+    {
+        p_tcb = (OS_TCB *)rt_thread_self();
+    }
+    
+    /*ֻOSTaskCreate()OS_TCBչԱ*/
+    if(OS_TCB_GET(&p_tcb->Task) == RT_NULL)
+    {
+        *p_err = OS_ERR_TCB_INVALID;
+        return (OS_TLS)0;
+    }
+    
+    if(p_tcb->TLS_Tbl == RT_NULL)/*OS_OPT_TASK_NO_TLS*/
+    {
+        *p_err = OS_ERR_TLS_NOT_EN;
+        return (OS_TLS)0;
+    }
+    
+    CPU_CRITICAL_ENTER();
+    value = p_tcb->TLS_Tbl[id];
+    CPU_CRITICAL_EXIT();
+    
+    *p_err = OS_ERR_NONE;
+    return value;
+}
+
+/*
+************************************************************************************************************************
+*                                          DEFINE TLS DESTRUCTOR FUNCTION
+*
+* Description: This function is called by the user to assign a 'destructor' function to a specific TLS.  When a task is
+*              deleted, all the destructors are called for all the task's TLS for which there is a destructor function
+*              defined.  In other when a task is deleted, all the non-NULL functions present in OS_TLS_DestructPtrTbl[]
+*              will be called.
+*
+* Arguments  : id          is the ID of the TLS destructor to set
+*
+*              p_destruct  is a pointer to a function that is associated with a specific TLS register and is called when
+*                          a task is deleted.  The prototype of such functions is:
+*
+*                            void  MyDestructFunction (OS_TCB     *p_tcb,
+*                                                      OS_TLS_ID   id,
+*                                                      OS_TLS      value);
+*
+*                          you can specify a NULL pointer if you don't want to have a fucntion associated with a TLS
+*                          register.  A NULL pointer (i.e. no function associated with a TLS register) is the default
+*                          value placed in OS_TLS_DestructPtrTbl[].
+*
+*              p_err       is a pointer to an error return code.  The possible values are:
+*
+*                            OS_ERR_NONE                    The call was successful.
+*                            OS_ERR_TLS_ID_INVALID          You you specified an invalid TLS ID
+*                            OS_ERR_TLS_DESTRUCT_ASSIGNED   If a destructor has already been assigned to the TLS ID
+*
+* Returns    : none
+*
+* Note(s)    : 1) ڵOSTaskDel()б
+************************************************************************************************************************
+*/
+
+void  OS_TLS_SetDestruct (OS_TLS_ID             id,
+                          OS_TLS_DESTRUCT_PTR   p_destruct,
+                          OS_ERR               *p_err)
+{
+    CPU_SR_ALLOC();
+    
+    if(id >= OS_TLS_NextAvailID)/*IDδ*/
+    {
+        *p_err = OS_ERR_TLS_ID_INVALID;
+        return;
+    }
+    
+    CPU_CRITICAL_ENTER();
+    if(OS_TLS_DestructPtrTbl[id] != (OS_TLS_DESTRUCT_PTR)0)/*Ѿָ*/
+    {
+        CPU_CRITICAL_EXIT();
+        *p_err = OS_ERR_TLS_DESTRUCT_ASSIGNED;
+        return;
+    }
+    OS_TLS_DestructPtrTbl[id] = p_destruct;
+    CPU_CRITICAL_EXIT();
+    
+    *p_err = OS_ERR_NONE;
+}
+
+/*
+************************************************************************************************************************
+*                                       SET THE CURRENT VALUE OF A TASK TLS REGISTER
+*
+* Description: This function is called to change the current value of a task TLS register.
+*
+* Arguments  : p_tcb     is a pointer to the OS_TCB of the task you want to set the task's TLS register for.  If 'p_tcb'
+*                        is a NULL pointer then you will change the TLS register of the current task.
+*
+*              id        is the 'id' of the desired task TLS register.  Note that the 'id' must be less than
+*                        'OS_TLS_NextAvailID'
+*
+*              value     is the desired value for the task TLS register.
+*
+*              p_err     is a pointer to a variable that will hold an error code related to this call.
+*
+*                            OS_ERR_NONE            if the call was successful
+*                            OS_ERR_TLS_ID_INVALID  if you specified an invalid TLS ID
+*                            OS_ERR_TLS_NOT_EN      if the task was created by specifying that TLS support was not
+*                                                     needed for the task
+*                            OS_ERR_TCB_INVALID     if the task was not created by OSTaskCreate()
+*
+* Returns    : none
+************************************************************************************************************************
+*/
+
+void  OS_TLS_SetValue (OS_TCB     *p_tcb,
+                       OS_TLS_ID   id,
+                       OS_TLS      value,
+                       OS_ERR     *p_err)
+{
+    CPU_SR_ALLOC();
+    
+    if(id >= OS_TLS_NextAvailID)/*IDδ*/
+    {
+        *p_err = OS_ERR_TLS_ID_INVALID;
+        return;
+    }
+    
+    /*TCBָΪNULL,ʾǰ*/
+    if(p_tcb == RT_NULL)
+    {
+        p_tcb = (OS_TCB *)rt_thread_self();
+    }
+    
+    /*ֻOSTaskCreate()OS_TCBչԱ*/
+    if(OS_TCB_GET(&p_tcb->Task) == RT_NULL)
+    {
+        *p_err = OS_ERR_TCB_INVALID;
+        return;
+    }
+    
+    if(p_tcb->TLS_Tbl == RT_NULL)/*OS_OPT_TASK_NO_TLS*/
+    {
+        *p_err = OS_ERR_TLS_NOT_EN;
+        return;
+    }
+    
+    CPU_CRITICAL_ENTER();
+    p_tcb->TLS_Tbl[id] = value;
+    CPU_CRITICAL_EXIT();
+    
+    *p_err = OS_ERR_NONE;
+}
+
+/*
+************************************************************************************************************************
+*                                         TASK CREATE HOOK FOR TLS
+*
+* Description: This function is called by OSTaskCreate() to set up the TLS table of a newly created task.
+*
+* Arguments  : p_tcb        is a pointer to the OS_TCB of the task being created
+*
+*              p_stk_base   is the base (lowest address) of the task's stack, the table is placed there
+*
+*              opt          is the option passed to OSTaskCreate()
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+************************************************************************************************************************
+*/
+
+void  OS_TLS_TaskCreate (OS_TCB   *p_tcb,
+                         CPU_STK  *p_stk_base,
+                         OS_OPT    opt)
+{
+    OS_TLS_ID  id;
+    
+    if((opt & OS_OPT_TASK_NO_TLS) != 0)/*ҪTLS,ռκοռ*/
+    {
+        p_tcb->TLS_Tbl = RT_NULL;
+        return;
+    }
+    
+    p_tcb->TLS_Tbl = (OS_TLS *)p_stk_base;
+    for(id = 0; id < OS_CFG_TLS_TBL_SIZE; id++)
+    {
+        p_tcb->TLS_Tbl[id] = (OS_TLS)0;
+    }
+}
+
+/*
+************************************************************************************************************************
+*                                          TASK DELETE HOOK FOR TLS
+*
+* Description: This function is called by OSTaskDel() to call the destructors of every TLS register of the task being
+*              deleted.
+*
+* Arguments  : p_tcb     is a pointer to the OS_TCB of the task being deleted
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application must not call it.
+************************************************************************************************************************
+*/
+
+void  OS_TLS_TaskDel (OS_TCB  *p_tcb)
+{
+    OS_TLS_ID            id;
+    OS_TLS_DESTRUCT_PTR  p_destruct;
+    
+    if(p_tcb->TLS_Tbl == RT_NULL)
+    {
+        return;
+    }
+    
+    for(id = 0; id < OS_TLS_NextAvailID; id++)
+    {
+        p_destruct = OS_TLS_DestructPtrTbl[id];
+        if(p_destruct != (OS_TLS_DESTRUCT_PTR)0)
+        {
+            p_destruct(p_tcb, id, p_tcb->TLS_Tbl[id]);
+        }
+    }
+}
+
+#endif
@@ -89,6 +89,9 @@ typedef   CPU_INT32U      OS_RATE_HZ;                  /* Rate in Hertz
 typedef   CPU_INT32U      OS_REG;                      /* Task register                                     8/16/<32> */
 typedef   CPU_INT08U      OS_REG_ID;                   /* Index to task register                            <8>/16/32 */
 
+typedef   void           *OS_TLS;                      /* Task Local Storage value                                 */
+typedef   CPU_DATA        OS_TLS_ID;                   /* Index to task local storage                              */
+
 typedef   CPU_INT32U      OS_SEM_CTR;                  /* Semaphore value                                     16/<32> */
 
 typedef   CPU_INT08U      OS_STATE;                    /* State variable                                    <8>/16/32 */